@@ -0,0 +1,164 @@
+// Copyright © 2024 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file operators.hpp
+ * @brief Implementations of the SLCS operators other than somewhere.
+ */
+
+#ifndef FCPP_OPERATORS_H_
+#define FCPP_OPERATORS_H_
+
+#include "lib/somewhere.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Namespace containing the implementations of everywhere (the formula holds on every device).
+namespace everywhere {
+
+//! @brief Oracle implementation (does not compute, just reads the correct value).
+struct oracle {
+    FUN bool operator()(ARGS, bool, bool val) const { CODE
+        nbr(CALL, true);
+        return val;
+    }
+    FUN_EXPORT export_t = export_list<bool>;
+};
+
+//! @brief Baseline implementation, as the dual of the somewhere baseline.
+struct baseline {
+    FUN bool operator()(ARGS, bool f, hops_t diameter) const { CODE
+        return not somewhere::baseline{}(CALL, not f, diameter);
+    }
+    FUN_EXPORT export_t = somewhere::baseline::export_t;
+};
+
+//! @brief Fastest implementation, as the dual of the somewhere fastest.
+struct fastest {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed) const { CODE
+        return not somewhere::fastest{}(CALL, not f, diameter, infospeed);
+    }
+    FUN_EXPORT export_t = somewhere::fastest::export_t;
+};
+
+} // namespace everywhere
+
+/**
+ * @brief Namespace containing the implementations of near (the formula holds on the device or a neighbour).
+ *
+ * The baseline already exchanges a single truth value per round, so that it has no optimised variant.
+ */
+namespace nearby {
+
+//! @brief Oracle implementation (does not compute, just reads the correct value).
+struct oracle {
+    FUN bool operator()(ARGS, bool, bool val) const { CODE
+        nbr(CALL, true);
+        return val;
+    }
+    FUN_EXPORT export_t = export_list<bool>;
+};
+
+//! @brief Baseline implementation, with the current value on the device and the latest received from neighbours.
+struct baseline {
+    FUN bool operator()(ARGS, bool f) const { CODE
+        return any_hood(CALL, nbr(CALL, f), f);
+    }
+    FUN_EXPORT export_t = export_list<bool>;
+};
+
+} // namespace nearby
+
+/**
+ * @brief Namespace containing the implementations of reach.
+ *
+ * The formula `reach(f, g)` holds on a device if there is a path from it to a device where `g` holds,
+ * such that `f` holds on every device of the path but the last (including the device itself).
+ */
+namespace reach {
+
+//! @brief Oracle implementation (does not compute, just reads the correct value).
+struct oracle {
+    FUN bool operator()(ARGS, bool, bool, bool val) const { CODE
+        nbr(CALL, true);
+        return val;
+    }
+    FUN_EXPORT export_t = export_list<bool>;
+};
+
+//! @brief Baseline implementation, by a hop-count gradient from `g` through `f` saturating at the diameter.
+struct baseline {
+    FUN bool operator()(ARGS, bool f, bool g, hops_t diameter) const { CODE
+        return nbr(CALL, diameter, [&](field<hops_t> n){
+            return saturating_hops(CALL, n, g, f, diameter);
+        });
+    }
+    FUN_EXPORT export_t = export_list<hops_t>;
+};
+
+/**
+ * @brief Fastest implementation, gossiping a netstate of the devices where `g` holds.
+ *
+ * Netstates of neighbours are merged only by devices where `f` holds, so that entries travel
+ * along paths through `f` only, while the other devices share their own entry alone.
+ */
+struct fastest {
+    FUN bool operator()(ARGS, bool f, bool g, hops_t diameter, real_t infospeed) const { CODE
+        return nbr(CALL, somewhere::netstate{}, [&](field<somewhere::netstate> n){
+            somewhere::netstate s = f ? somewhere::netstate::merge(n) : somewhere::netstate{};
+            s.update(node.uid, node.current_time(), g);
+            times_t threshold = node.current_time() - diameter / infospeed;
+            s.prune(threshold);
+            return make_tuple(s.value(threshold), std::move(s));
+        });
+    }
+    FUN_EXPORT export_t = export_list<somewhere::netstate>;
+};
+
+} // namespace reach
+
+/**
+ * @brief Namespace containing the implementations of surrounded.
+ *
+ * The formula `surrounded(f, g)` holds on a device where `f` holds, if every path from it
+ * to a device where neither `f` nor `g` hold passes through a device where `g` holds.
+ */
+namespace surrounded {
+
+//! @brief Oracle implementation (does not compute, just reads the correct value).
+struct oracle {
+    FUN bool operator()(ARGS, bool, bool, bool val) const { CODE
+        nbr(CALL, true);
+        return val;
+    }
+    FUN_EXPORT export_t = export_list<bool>;
+};
+
+//! @brief Baseline implementation, as the negation of reaching outside of `f` and `g` while avoiding `g`.
+struct baseline {
+    FUN bool operator()(ARGS, bool f, bool g, hops_t diameter) const { CODE
+        return f and not reach::baseline{}(CALL, not g, not f and not g, diameter);
+    }
+    FUN_EXPORT export_t = reach::baseline::export_t;
+};
+
+//! @brief Fastest implementation, as the negation of reaching outside of `f` and `g` while avoiding `g`.
+struct fastest {
+    FUN bool operator()(ARGS, bool f, bool g, hops_t diameter, real_t infospeed) const { CODE
+        return f and not reach::fastest{}(CALL, not g, not f and not g, diameter, infospeed);
+    }
+    FUN_EXPORT export_t = reach::fastest::export_t;
+};
+
+} // namespace surrounded
+
+} // namespace coordination
+
+} // namespace fcpp
+
+#endif // FCPP_OPERATORS_H_
@@ -0,0 +1,548 @@
+// Copyright © 2024 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file runner.hpp
+ * @brief Parallel execution of batches of simulations, with work stealing among threads, journaling and sharding.
+ */
+
+#ifndef FCPP_RUNNER_H_
+#define FCPP_RUNNER_H_
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "lib/fcpp.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Namespace containing the parallel batch runner.
+namespace runner {
+
+//! @brief Output archive writing values in binary form to a stream.
+class binary_writer {
+  public:
+    //! @brief Constructor given the stream to write into.
+    binary_writer(std::ostream& os) : m_os(os) {}
+
+    //! @brief Writes an arithmetic value, a string, or a value with a serialize member function.
+    template <typename T>
+    binary_writer& operator<<(T const& x) {
+        if constexpr (std::is_arithmetic<T>::value) m_os.write(reinterpret_cast<char const*>(&x), sizeof(T));
+        else if constexpr (std::is_same<T, std::string>::value) {
+            *this << uint64_t(x.size());
+            m_os.write(x.data(), x.size());
+        } else x.serialize(*this);
+        return *this;
+    }
+
+    //! @brief Writes a value (as operator<<).
+    template <typename T>
+    binary_writer& operator&(T const& x) {
+        return *this << x;
+    }
+
+  private:
+    //! @brief The stream to write into.
+    std::ostream& m_os;
+};
+
+/**
+ * @brief Input archive reading values in binary form from a stream, as written by binary_writer.
+ *
+ * Strings longer than `max_length` are rejected, failing the stream, so that a corrupted
+ * length prefix does not allocate an arbitrary amount of memory.
+ */
+class binary_reader {
+  public:
+    //! @brief The maximum length of strings read.
+    static constexpr uint64_t max_length = uint64_t(1) << 32;
+
+    //! @brief Constructor given the stream to read from.
+    binary_reader(std::istream& is) : m_is(is) {}
+
+    //! @brief Reads an arithmetic value, a string, or a value with a serialize member function.
+    template <typename T>
+    binary_reader& operator>>(T& x) {
+        if constexpr (std::is_arithmetic<T>::value) m_is.read(reinterpret_cast<char*>(&x), sizeof(T));
+        else if constexpr (std::is_same<T, std::string>::value) {
+            uint64_t n = 0;
+            *this >> n;
+            if (not m_is or n > max_length) {
+                m_is.setstate(std::ios::failbit);
+                x.clear();
+                return *this;
+            }
+            x.resize(n);
+            m_is.read(&x[0], n);
+        } else x.serialize(*this);
+        return *this;
+    }
+
+    //! @brief Whether every read succeeded so far.
+    explicit operator bool() const {
+        return bool(m_is);
+    }
+
+    //! @brief Reads a value (as operator>>).
+    template <typename T>
+    binary_reader& operator&(T& x) {
+        return *this >> x;
+    }
+
+  private:
+    //! @brief The stream to read from.
+    std::istream& m_is;
+};
+
+/**
+ * @brief Plotter forwarding rows to a plot P, or buffering them to be forwarded later.
+ *
+ * Every simulation of a batch writes into its own buffering recorder, whose rows are passed
+ * to the shared plot at once when the simulation ends, so that threads do not contend for it.
+ * Buffered rows can also be saved to a stream, and loaded back into a plot by a later execution,
+ * provided that the type of rows of the plot has been registered through `register_rows`.
+ *
+ * The type of rows is only known where the simulator writes them: `rows_registration` calls `register_rows`
+ * at program start for every type of rows written, so that loading works even before any row is written.
+ */
+template <typename P>
+class recorder {
+  public:
+    //! @brief Constructor (forwarding rows to its own plot unless `buffering`).
+    recorder(bool buffering = false) : m_buffering(buffering) {}
+
+    /**
+     * @brief Registers R as the type of rows of the plot, to be read when loading rows saved by another execution.
+     *
+     * Rows of a plot have a single type: registering a different one makes loading fail.
+     */
+    template <typename R>
+    static void register_rows() {
+        if (loader() and loader_type() != typeid(R)) loader() = nullptr;
+        else loader() = [](binary_reader& r, P& p){
+            R row;
+            if (r >> row) p << row;
+        };
+        loader_type() = typeid(R);
+    }
+
+    //! @brief Registers the type R of rows at program start, when instantiated.
+    template <typename R>
+    struct rows_registration {
+        static inline bool const done = (register_rows<R>(), true);
+    };
+
+    //! @brief Passes a row to the plot, or buffers it.
+    template <typename R>
+    recorder& operator<<(R const& row) {
+        (void)rows_registration<R>::done;
+        if (m_buffering) m_rows.push_back([row](P* p, binary_writer* w){
+            if (p) *p << row;
+            else *w << row;
+        });
+        else m_plot << row;
+        return *this;
+    }
+
+    //! @brief Passes the buffered rows to the plot of another recorder, emptying the buffer.
+    void flush(recorder& r) {
+        for (auto const& x : m_rows) x(&r.m_plot, nullptr);
+        m_rows.clear();
+    }
+
+    //! @brief Saves the buffered rows to a stream.
+    void save(std::ostream& os) const {
+        binary_writer w(os);
+        for (auto const& x : m_rows) x(nullptr, &w);
+    }
+
+    //! @brief Loads rows saved by another execution from a stream into the plot, returning false if they cannot be read.
+    bool load(std::istream& is) {
+        if (not loader()) return false;
+        binary_reader r(is);
+        while (r and is.peek() != std::char_traits<char>::eof()) loader()(r, m_plot);
+        return bool(r);
+    }
+
+    //! @brief Builds the plot.
+    auto build() {
+        return m_plot.build();
+    }
+
+  private:
+    //! @brief A buffered row, as a function passing it to a plot (if not null) or saving it.
+    using row_function = std::function<void(P*, binary_writer*)>;
+
+    //! @brief The function reading a row and passing it to a plot (empty if no type of rows is registered).
+    static std::function<void(binary_reader&, P&)>& loader() {
+        static std::function<void(binary_reader&, P&)> f;
+        return f;
+    }
+
+    //! @brief The type of rows registered.
+    static std::type_index& loader_type() {
+        static std::type_index t = typeid(void);
+        return t;
+    }
+
+    //! @brief Whether rows are buffered.
+    bool m_buffering;
+    //! @brief The plot.
+    P m_plot;
+    //! @brief The buffered rows.
+    std::vector<row_function> m_rows;
+};
+
+/**
+ * @brief Journal of completed simulations, keyed by their output file name (encoding their parameters).
+ *
+ * The file starts with a header holding the journal format version and a hash of the configuration
+ * (the type of the plot, thus of the implementations and values plotted), and journals with a different
+ * header are rejected. Each record holds the key and the rows plotted by the simulation, and is appended
+ * and flushed when the simulation ends. A record truncated by an interrupted execution is ignored when reading.
+ */
+template <typename P>
+class journal {
+  public:
+    //! @brief The version of the journal format.
+    static constexpr uint32_t version = 2;
+
+    //! @brief Constructor reading the records from a file (none if the name is empty).
+    journal(std::string file) : m_file(file) {
+        if (file.empty()) return;
+        std::streamoff valid = 0;
+        if (std::filesystem::exists(file) and std::filesystem::file_size(file) > 0) {
+            std::ifstream is(file, std::ios::binary);
+            m_valid = header(is);
+            if (m_valid) valid = read(is, m_done);
+            is.close();
+            if (not m_valid) return;
+            // drops a truncated record, so that new records are appended after the complete ones
+            std::filesystem::resize_file(file, valid);
+            m_out.open(file, std::ios::binary | std::ios::app);
+        } else {
+            m_out.open(file, std::ios::binary | std::ios::trunc);
+            binary_writer(m_out) << version << config_hash();
+            m_out.flush();
+        }
+    }
+
+    /**
+     * @brief Reads the complete simulations in a journal file into a journal, without modifying the file.
+     *
+     * Nothing can be recorded in the resulting journal. Returns false if the file cannot be read or has a different header.
+     */
+    static bool read_only(std::string const& file, journal& log) {
+        std::ifstream is(file, std::ios::binary);
+        if (not is or not header(is)) return false;
+        read(is, log.m_done);
+        return true;
+    }
+
+    //! @brief Whether the journal file has the header of this configuration (or is new).
+    bool valid() const {
+        return m_valid;
+    }
+
+    //! @brief Whether a simulation with a given key is complete.
+    bool done(std::string const& key) const {
+        return m_done.count(key) > 0;
+    }
+
+    //! @brief Loads the rows of a complete simulation into a recorder, returning false if they cannot be read.
+    bool replay(std::string const& key, recorder<P>& r) const {
+        std::istringstream is(m_done.at(key));
+        return r.load(is);
+    }
+
+    //! @brief Records a simulation as complete, with the rows buffered by a recorder.
+    void record(std::string const& key, recorder<P> const& r) {
+        if (m_file.empty()) return;
+        std::ostringstream os;
+        r.save(os);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        binary_writer(m_out) << key << os.str();
+        m_out.flush();
+    }
+
+  private:
+    //! @brief A hash of the configuration (FNV-1a of the name of the plot type).
+    static uint64_t config_hash() {
+        uint64_t h = 14695981039346656037ULL;
+        for (char c : std::string(typeid(P).name())) h = (h ^ uint8_t(c)) * 1099511628211ULL;
+        return h;
+    }
+
+    //! @brief Reads the header from a stream, returning whether it matches this version and configuration.
+    static bool header(std::istream& is) {
+        uint32_t v = 0;
+        uint64_t h = 0;
+        binary_reader r(is);
+        return (r >> v >> h) and v == version and h == config_hash();
+    }
+
+    /**
+     * @brief Reads the complete records from a stream (after the header), returning the offset after the last of them.
+     *
+     * Reading stops at the first record which is truncated or has a length over the maximum.
+     */
+    static std::streamoff read(std::istream& is, std::unordered_map<std::string, std::string>& done) {
+        binary_reader r(is);
+        std::string key, rows;
+        std::streamoff valid = is.tellg();
+        while (r >> key >> rows) {
+            done[key] = rows;
+            valid = is.tellg();
+        }
+        return valid;
+    }
+
+    //! @brief The name of the journal file.
+    std::string m_file;
+    //! @brief Whether the journal file has the header of this configuration.
+    bool m_valid = true;
+    //! @brief The stream appending to the journal file.
+    std::ofstream m_out;
+    //! @brief The rows of complete simulations by key.
+    std::unordered_map<std::string, std::string> m_done;
+    //! @brief A mutex guarding the journal file.
+    std::mutex m_mutex;
+};
+
+//! @brief Settings of a batch execution.
+struct settings {
+    //! @brief The number of threads.
+    size_t threads = 1;
+    //! @brief The journal file of complete simulations (none if empty).
+    std::string journal;
+    //! @brief The index of the shard of simulations to be run.
+    size_t shard = 0;
+    //! @brief The number of shards in which simulations are split.
+    size_t shards = 1;
+};
+
+//! @brief A simulation to be run, with its key and an estimate of its cost.
+template <typename P>
+struct task {
+    //! @brief The key of the simulation (its output file name).
+    std::string key;
+    //! @brief Runs the simulation writing into a given recorder, returning its duration in seconds.
+    std::function<double(recorder<P>&)> run;
+    //! @brief The estimated cost of the simulation (in arbitrary units).
+    double cost;
+};
+
+/**
+ * @brief Work-stealing queues of tasks, one for every thread.
+ *
+ * Threads take tasks from the front of their own queue, and when it is empty they steal
+ * from the front of the queues of the other threads. Queues filled in decreasing order of cost
+ * are thus consumed largest-first, so that the longest tasks do not end up in the tail.
+ */
+template <typename P>
+class work_queues {
+  public:
+    //! @brief Constructor for a given number of threads.
+    work_queues(size_t threads) : m_queues(threads), m_mutexes(threads) {}
+
+    //! @brief Adds a task to the queue of a thread.
+    void push(size_t thread, task<P> t) {
+        std::lock_guard<std::mutex> lock(m_mutexes[thread]);
+        m_queues[thread].push_back(std::move(t));
+    }
+
+    //! @brief Takes a task for a thread into `t`, returning false if there are none left.
+    bool pop(size_t thread, task<P>& t) {
+        size_t n = m_queues.size();
+        for (size_t i = 0; i < n; ++i) {
+            size_t q = (thread + i) % n;
+            std::lock_guard<std::mutex> lock(m_mutexes[q]);
+            if (m_queues[q].empty()) continue;
+            t = std::move(m_queues[q].front());
+            m_queues[q].pop_front();
+            return true;
+        }
+        return false;
+    }
+
+  private:
+    //! @brief The queues of tasks.
+    std::vector<std::deque<task<P>>> m_queues;
+    //! @brief The mutexes guarding the queues.
+    std::vector<std::mutex> m_mutexes;
+};
+
+//! @brief Appends a task for every element of a sequence of initialisation values for component T, with costs estimated by C.
+template <typename T, typename P, typename C, typename S>
+void append_tasks(std::vector<task<P>>& tasks, C const& cost, S const& s) {
+    for (size_t i = 0; i < s.size(); ++i) {
+        auto init = s[i];
+        tasks.push_back({std::string(common::get<component::tags::output>(init)), [&s,i](recorder<P>& r){
+            auto init = s[i];
+            common::get<component::tags::plotter>(init) = &r;
+            auto start = std::chrono::high_resolution_clock::now();
+            {
+                typename T::net network{init};
+                network.run();
+            }
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            return elapsed.count();
+        }, double(cost(init))});
+    }
+}
+
+//! @brief Runs tasks in order on a number of threads, passing their plots to a recorder and journal, and returning the total duration of tasks.
+template <typename P>
+double run_tasks(std::vector<task<P>> tasks, size_t threads, recorder<P>& plotter, journal<P>& log) {
+    work_queues<P> queues(threads);
+    for (size_t i = 0; i < tasks.size(); ++i)
+        queues.push(i % threads, std::move(tasks[i]));
+    std::mutex plotter_mutex;
+    std::vector<double> busy(threads, 0);
+    std::vector<std::thread> workers;
+    for (size_t w = 0; w < threads; ++w)
+        workers.emplace_back([&,w](){
+            task<P> t;
+            while (queues.pop(w, t)) {
+                recorder<P> r(true);
+                busy[w] += t.run(r);
+                log.record(t.key, r);
+                std::lock_guard<std::mutex> lock(plotter_mutex);
+                r.flush(plotter);
+            }
+        });
+    for (std::thread& t : workers) t.join();
+    double total = 0;
+    for (double b : busy) total += b;
+    return total;
+}
+
+//! @brief The tasks for every element of the given sequences of initialisation values for component T, in decreasing order of cost.
+template <typename T, typename P, typename C, typename... S>
+std::vector<task<P>> sorted_tasks(C const& cost, S const&... s) {
+    std::vector<task<P>> tasks;
+    (append_tasks<T>(tasks, cost, s), ...);
+    std::stable_sort(tasks.begin(), tasks.end(), [](task<P> const& x, task<P> const& y){
+        return x.cost > y.cost;
+    });
+    return tasks;
+}
+
+/**
+ * @brief Runs the simulations of component T for every element of the given sequences, on a number of threads.
+ *
+ * Simulations are scheduled largest-first (longest processing time), according to the cost
+ * estimated by applying `cost` to their initialisation values. The plotter stored in the
+ * initialisation values is replaced by a buffer for each simulation, whose rows are then passed
+ * to the given plotter. The speed-up (total duration of simulations over elapsed time)
+ * is reported on standard error. Completed simulations are recorded in the journal file
+ * (if not empty), so that a later execution loads their rows instead of running them again.
+ *
+ * Only the simulations in the given shard are considered, dealing them to shards in order of cost,
+ * so that executions with the same sequences and different shards split the work evenly.
+ * Returns false (after reporting it on standard error) if the journal cannot be used.
+ */
+template <typename T, typename P, typename C, typename... S>
+bool run(T, settings const& opt, recorder<P>& plotter, C const& cost, S const&... s) {
+    std::vector<task<P>> tasks = sorted_tasks<T, P>(cost, s...);
+    journal<P> log(opt.journal);
+    if (not log.valid()) {
+        std::cerr << "runner: journal " << opt.journal << " has a different version or configuration" << std::endl;
+        return false;
+    }
+    std::vector<task<P>> missing;
+    size_t count = 0;
+    for (size_t i = opt.shard; i < tasks.size(); i += std::max<size_t>(1, opt.shards), ++count) {
+        if (not log.done(tasks[i].key)) missing.push_back(std::move(tasks[i]));
+        else if (not log.replay(tasks[i].key, plotter)) {
+            std::cerr << "runner: cannot read rows of " << tasks[i].key << " from journal " << opt.journal << std::endl;
+            return false;
+        }
+    }
+    std::cerr << "runner: " << count - missing.size() << " of " << count << " runs loaded from journal" << std::endl;
+    size_t threads = std::max<size_t>(1, opt.threads);
+    auto start = std::chrono::high_resolution_clock::now();
+    double total = run_tasks(std::move(missing), threads, plotter, log);
+    std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+    std::cerr << "runner: " << threads << " threads, " << elapsed.count() << "s elapsed, speed-up " << total / elapsed.count() << std::endl;
+    return true;
+}
+
+/**
+ * @brief Runs the simulations of component T for every element of the given sequences, once for each given number of threads.
+ *
+ * Simulations are scheduled as in `run`, without journal and discarding their plots. A table with the
+ * elapsed time and the speed-up with respect to the first number of threads is printed on standard output.
+ */
+template <typename P, typename T, typename C, typename... S>
+void scaling(T, std::vector<size_t> const& thread_counts, C const& cost, S const&... s) {
+    std::vector<task<P>> tasks = sorted_tasks<T, P>(cost, s...);
+    journal<P> log("");
+    double base = 0;
+    std::cout << "threads\telapsed (s)\tspeed-up" << std::endl;
+    for (size_t threads : thread_counts) {
+        recorder<P> plotter;
+        auto start = std::chrono::high_resolution_clock::now();
+        run_tasks(tasks, std::max<size_t>(1, threads), plotter, log);
+        std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+        if (base == 0) base = elapsed.count();
+        std::cout << threads << "\t" << elapsed.count() << "\t" << base / elapsed.count() << std::endl;
+    }
+}
+
+/**
+ * @brief Loads into a plotter the rows of the simulations of component T for every element of the given sequences,
+ * from the journal files of the shards they were split into by `run` (one file per shard, in order).
+ *
+ * The files are only read. Returns false (after reporting it on standard error) if some file cannot be read,
+ * or misses some simulation of its shard.
+ */
+template <typename T, typename P, typename C, typename... S>
+bool merge(T, std::vector<std::string> const& journal_files, recorder<P>& plotter, C const& cost, S const&... s) {
+    std::vector<task<P>> tasks = sorted_tasks<T, P>(cost, s...);
+    size_t shards = journal_files.size();
+    for (size_t shard = 0; shard < shards; ++shard) {
+        std::string const& file = journal_files[shard];
+        journal<P> log("");
+        if (not journal<P>::read_only(file, log)) {
+            std::cerr << "runner: cannot read journal " << file << std::endl;
+            return false;
+        }
+        size_t missing = 0, count = 0;
+        for (size_t i = shard; i < tasks.size(); i += shards, ++count)
+            if (not log.done(tasks[i].key)) ++missing;
+        if (missing > 0) {
+            std::cerr << "runner: journal " << file << " misses " << missing << " of " << count << " runs" << std::endl;
+            return false;
+        }
+        for (size_t i = shard; i < tasks.size(); i += shards)
+            if (not log.replay(tasks[i].key, plotter)) {
+                std::cerr << "runner: cannot read rows of " << tasks[i].key << " from journal " << file << std::endl;
+                return false;
+            }
+        std::cerr << "runner: " << count << " runs loaded from " << file << std::endl;
+    }
+    return true;
+}
+
+} // namespace runner
+
+} // namespace fcpp
+
+#endif // FCPP_RUNNER_H_
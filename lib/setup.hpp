@@ -5,7 +5,12 @@
  * @brief Network configuration of the experimental evaluation.
  */
 #define FCPP_TRACE 32
+#include <chrono>
+#include <utility>
+
 #include "lib/fcpp.hpp"
+#include "lib/operators.hpp"
+#include "lib/runner.hpp"
 #include "lib/somewhere.hpp"
 
 /**
@@ -25,6 +30,56 @@ constexpr size_t comm = 100;
 constexpr size_t dim = 2;
 //! @brief Height of the deployment area.
 constexpr size_t height = comm;
+//! @brief Maximum diameter (in hops) for implementations with saturating hop counts.
+constexpr size_t max_diameter = 255;
+//! @brief Number of propositions for the smaller runs of multi-proposition implementations.
+constexpr size_t few_props = 8;
+//! @brief Number of propositions for the larger runs of multi-proposition implementations.
+constexpr size_t many_props = 64;
+//! @brief The implementations (besides oracles), each running alone in the lane with its index (starting from 1).
+using lane_algorithms = common::type_sequence<
+    coordination::somewhere::baseline,
+    coordination::somewhere::saturating_baseline<max_diameter>,
+    coordination::somewhere::lazy_baseline,
+    coordination::somewhere::knowledge_free,
+    coordination::somewhere::replicated,
+    coordination::somewhere::split_replicated,
+    coordination::somewhere::bitwise_replicated,
+    coordination::somewhere::lazy_bitwise_replicated,
+    coordination::somewhere::fastest,
+    coordination::somewhere::delta_fastest,
+    coordination::somewhere::tailored_fastest,
+    coordination::somewhere::sparse_fastest,
+    coordination::somewhere::hierarchical_fastest,
+    coordination::somewhere::timestamp_gossip,
+    coordination::somewhere::hybrid,
+    coordination::somewhere::multi_baseline<few_props>,
+    coordination::somewhere::multi_baseline<many_props>,
+    coordination::somewhere::multi_replicated<few_props>,
+    coordination::somewhere::multi_replicated<many_props>,
+    coordination::somewhere::multi_fastest<few_props>,
+    coordination::somewhere::multi_fastest<many_props>,
+    coordination::everywhere::baseline,
+    coordination::everywhere::fastest,
+    coordination::nearby::baseline,
+    coordination::reach::baseline,
+    coordination::reach::fastest,
+    coordination::surrounded::baseline,
+    coordination::surrounded::fastest
+>;
+//! @brief Number of implementations (besides oracles), each running alone in the lane with its index.
+constexpr size_t lanes = lane_algorithms::size;
+
+//! @brief The index of an implementation in a sequence, starting from 1 (zero if it does not occur).
+template <typename F, typename... As>
+constexpr size_t lane_index(common::type_sequence<As...>) {
+    size_t i = 0, k = 0;
+    ((++i, k = std::is_same<F, As>::value ? i : k), ...);
+    return k;
+}
+//! @brief The lane of an implementation (zero if it is not in lane_algorithms, thus running only in lane 0).
+template <typename F>
+constexpr size_t lane_of = lane_index<F>(lane_algorithms{});
 
 
 //! @brief Namespace containing the libraries of coordination routines.
@@ -45,6 +100,12 @@ namespace tags {
     struct devices {};
     //! @brief The side of deployment area.
     struct side {};
+    //! @brief The number of replicas used by replicated implementations.
+    struct replicas {};
+    //! @brief The speed of information propagation in hops per second (estimated online and agreed across the network if zero).
+    struct infospeed {};
+    //! @brief The implementation running alone in the simulation (all of them if zero).
+    struct lane {};
     //! @brief Color of the current node.
     struct node_color {};
     //! @brief Size of the current node.
@@ -69,17 +130,83 @@ namespace tags {
     template <typename T> struct error {};
     //! @brief The size of messages used by an implementation.
     template <typename T> struct msg_size {};
+    //! @brief Whether an implementation actually sent a message in the latest round.
+    template <typename T> struct msg_sent {};
+    //! @brief The size of the message after the latest implementation executed.
+    struct msg_mark {};
+    //! @brief The time spent computing an implementation (in microseconds).
+    template <typename T> struct run_time {};
+    //! @brief The average number of netstate entries sent to a single neighbour by an implementation.
+    template <typename T> struct link_mean {};
+    //! @brief The maximum number of netstate entries sent to a single neighbour by an implementation.
+    template <typename T> struct link_max {};
 }
 
 
-//! @brief Executes a somewhere implementation and stores data about it in the node storage.
-GEN(F, ...Ts) void reporter(ARGS, F&& fun, Ts&&... xs) { CODE
+//! @brief The oracle against which the error of an implementation is computed (that of somewhere by default).
+template <typename F> struct oracle_of { using type = somewhere::oracle; };
+//! @brief The oracle of everywhere implementations.
+template <> struct oracle_of<everywhere::oracle> { using type = everywhere::oracle; };
+template <> struct oracle_of<everywhere::baseline> { using type = everywhere::oracle; };
+template <> struct oracle_of<everywhere::fastest> { using type = everywhere::oracle; };
+//! @brief The oracle of near implementations.
+template <> struct oracle_of<nearby::oracle> { using type = nearby::oracle; };
+template <> struct oracle_of<nearby::baseline> { using type = nearby::oracle; };
+//! @brief The oracle of reach implementations.
+template <> struct oracle_of<reach::oracle> { using type = reach::oracle; };
+template <> struct oracle_of<reach::baseline> { using type = reach::oracle; };
+template <> struct oracle_of<reach::fastest> { using type = reach::oracle; };
+//! @brief The oracle of surrounded implementations.
+template <> struct oracle_of<surrounded::oracle> { using type = surrounded::oracle; };
+template <> struct oracle_of<surrounded::baseline> { using type = surrounded::oracle; };
+template <> struct oracle_of<surrounded::fastest> { using type = surrounded::oracle; };
+
+//! @brief The number of propositions computed at once by an implementation returning type T (one, unless it is a bitset).
+template <typename T> struct proposition_count : std::integral_constant<size_t, 1> {};
+//! @brief The number of propositions computed at once by a multi-proposition implementation.
+template <size_t N> struct proposition_count<std::bitset<N>> : std::integral_constant<size_t, N> {};
+
+//! @brief The truth value of the first proposition computed by an implementation.
+inline bool first_proposition(bool b) {
+    return b;
+}
+//! @brief The truth value of the first proposition computed by a multi-proposition implementation.
+template <size_t N>
+bool first_proposition(std::bitset<N> const& b) {
+    return b[0];
+}
+
+/**
+ * @brief Executes an SLCS operator implementation and stores data about it in the node storage,
+ * except for whether it sent a message.
+ *
+ * For multi-proposition implementations, the value and error refer to the first proposition, while the message
+ * size and running time are divided by the number of propositions, measuring the amortised cost per formula.
+ *
+ * The message size of the implementation is the growth of the message since the previous one. It is
+ * measured through node.cur_msg_size(), which serialises the whole message built so far: the export of a
+ * single implementation is not accessible, so that size_counter cannot be used here. Thus measuring sizes
+ * still costs a serialisation per reporter, of growing size, unless the implementation runs alone in its lane.
+ */
+GEN(F, ...Ts) void measurer(ARGS, F&& fun, Ts&&... xs) { CODE
     using namespace tags;
 
-    size_t msg_base = node.cur_msg_size();
-    node.storage(value<F>{}) = fun(CALL, std::forward<Ts>(xs)...);
-    node.storage(msg_size<F>{}) = node.cur_msg_size() - msg_base;
-    node.storage(error<F>{}) = node.storage(value<F>{}) != node.storage(value<somewhere::oracle>{});
+    size_t msg_base = node.storage(msg_mark{});
+    auto start = std::chrono::high_resolution_clock::now();
+    auto r = fun(CALL, std::forward<Ts>(xs)...);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+    constexpr size_t props = proposition_count<decltype(r)>::value;
+    node.storage(value<F>{}) = first_proposition(r);
+    node.storage(run_time<F>{}) = elapsed.count() / props;
+    node.storage(msg_mark{}) = node.cur_msg_size();
+    node.storage(msg_size<F>{}) = double(node.storage(msg_mark{}) - msg_base) / props;
+    node.storage(error<F>{}) = node.storage(value<F>{}) != node.storage(value<typename oracle_of<F>::type>{});
+}
+
+//! @brief Executes an SLCS operator implementation, which sends a message every round, and stores data about it in the node storage.
+GEN(F, ...Ts) void reporter(ARGS, F&& fun, Ts&&... xs) { CODE
+    measurer(CALL, std::forward<F>(fun), std::forward<Ts>(xs)...);
+    node.storage(tags::msg_sent<F>{}) = true;
 }
 //! @brief Export types used by the reporter function.
 GEN_EXPORT(F) reporter_t = export_list<typename F::export_t>;
@@ -87,15 +214,70 @@ GEN_EXPORT(F) reporter_t = export_list<typename F::export_t>;
 GEN_EXPORT(F) reporter_s = storage_list<
     tags::value<F>,         bool,
     tags::error<F>,         bool,
-    tags::msg_size<F>,      size_t
+    tags::msg_size<F>,      double,
+    tags::msg_sent<F>,      bool,
+    tags::run_time<F>,      double
 >;
 
+//! @brief Executes a lazy somewhere implementation, which reports through its last argument whether it sent its value, and stores data about it in the node storage.
+GEN(F, ...Ts) void lazy_reporter(ARGS, F&& fun, Ts&&... xs) { CODE
+    bool sent;
+    measurer(CALL, std::forward<F>(fun), std::forward<Ts>(xs)..., sent);
+    node.storage(tags::msg_sent<F>{}) = sent;
+}
+
+/**
+ * @brief Whether a path of connected devices leads from the current one to one where `g` holds, with `f` holding
+ * on every device of the path but the last, given predicates on device identifiers and positions.
+ *
+ * Computed by a breadth-first search over the devices within communication range at the current time,
+ * which only visits devices where `f` holds (and their neighbours).
+ */
+template <typename node_t, typename F, typename G>
+bool reachable(node_t& node, F&& f, G&& g) {
+    times_t t = node.current_time();
+    std::vector<vec<dim>> pos;
+    for (device_t i = 0; i < node.net.node_size(); ++i)
+        pos.push_back(node.net.node_at(i).position(t));
+    if (g(node.uid, pos[node.uid])) return true;
+    if (not f(node.uid, pos[node.uid])) return false;
+    std::vector<bool> visited(pos.size());
+    std::vector<device_t> queue = {node.uid};
+    visited[node.uid] = true;
+    for (size_t q = 0; q < queue.size(); ++q)
+        for (device_t i = 0; i < pos.size(); ++i)
+            if (not visited[i] and norm(pos[i] - pos[queue[q]]) < comm) {
+                if (g(i, pos[i])) return true;
+                visited[i] = true;
+                if (f(i, pos[i])) queue.push_back(i);
+            }
+    return false;
+}
+
+//! @brief The propositions for multi-proposition implementations: the i-th is true on device i while the formula holds somewhere.
+template <size_t N>
+std::bitset<N> propositions(device_t uid, bool somewhere_f) {
+    std::bitset<N> b;
+    if (somewhere_f and uid < N) b[uid] = true;
+    return b;
+}
+
 //! @brief Main function.
 MAIN() {
     using namespace tags;
     hops_t diameter = node.net.storage(hops{}) * 2; // hops
-    real_t infospeed = 2; // hop/s
-    int replicas = 3; // it can be a variable (
+    real_t infospeed = node.net.storage(tags::infospeed{}); // hop/s
+    // estimated online and agreed across the network, changing only every 2*diameter seconds (so that replica epochs agree)
+    if (infospeed <= 0) infospeed = shared_speed(CALL, propagation_speed(CALL, 2), 2 * diameter);
+    size_t replicas = node.net.storage(tags::replicas{});
+    size_t refresh = 10; // rounds between full netstate exports
+    size_t budget = 100; // netstate entries before switching to the baseline
+    times_t keepalive = 2; // seconds between sendings of unchanged values (below the retain time)
+    // the lane of the simulation: 0 runs every implementation, k > 0 only the k-th one in lane_algorithms (and the oracles)
+    size_t lane = node.net.storage(tags::lane{});
+    auto active = [&](auto f){
+        return lane == 0 or lane == lane_of<decltype(f)>;
+    };
 
     // random walk into a given rectangle with given speed
     rectangle_walk(CALL, make_vec(0,0), make_vec(1,1)*node.net.storage(side{}), node.net.storage(speed{}), 1);
@@ -103,12 +285,65 @@ MAIN() {
     // the value of the formula for the current event
     bool somewhere_f = node.current_time() > true_time and node.current_time() < false_time;
     bool formula = node.uid == 0 and somewhere_f;
+    // the regions around the device where the formula holds, for the other operators
+    vec<dim> source = node.net.node_at(0).position(node.current_time());
+    auto is_formula = [&](device_t i, vec<dim> const&){
+        return i == 0 and somewhere_f;
+    };
+    auto is_inner = [&](device_t, vec<dim> const& p){
+        return somewhere_f and norm(p - source) < 2*comm;
+    };
+    auto is_ring = [&](device_t i, vec<dim> const& p){
+        return somewhere_f and not is_inner(i, p) and norm(p - source) < 3*comm;
+    };
+    real_t source_dist = norm(node.position(node.current_time()) - source);
+    bool inner = is_inner(node.uid, node.position(node.current_time()));
+    bool ring = is_ring(node.uid, node.position(node.current_time()));
+    // the message size before the implementations, each measuring from the size left by the previous one
+    node.storage(msg_mark{}) = node.cur_msg_size();
 
     reporter(CALL, somewhere::oracle{}, formula, somewhere_f);
-    reporter(CALL, somewhere::baseline{}, formula, diameter);
-    reporter(CALL, somewhere::knowledge_free{}, formula);
-    reporter(CALL, somewhere::replicated{}, formula, diameter, infospeed, replicas);
-    reporter(CALL, somewhere::fastest{}, formula, diameter, infospeed);
+    if (active(somewhere::baseline{})) reporter(CALL, somewhere::baseline{}, formula, diameter);
+    if (active(somewhere::saturating_baseline<max_diameter>{})) reporter(CALL, somewhere::saturating_baseline<max_diameter>{}, formula, diameter);
+    if (active(somewhere::lazy_baseline{})) lazy_reporter(CALL, somewhere::lazy_baseline{}, formula, diameter, keepalive);
+    if (active(somewhere::knowledge_free{})) reporter(CALL, somewhere::knowledge_free{}, formula);
+    if (active(somewhere::replicated{})) reporter(CALL, somewhere::replicated{}, formula, diameter, infospeed, replicas);
+    if (active(somewhere::split_replicated{})) reporter(CALL, somewhere::split_replicated{}, formula, diameter, infospeed, replicas);
+    if (active(somewhere::bitwise_replicated{})) reporter(CALL, somewhere::bitwise_replicated{}, formula, diameter, infospeed, replicas);
+    if (active(somewhere::lazy_bitwise_replicated{})) lazy_reporter(CALL, somewhere::lazy_bitwise_replicated{}, formula, diameter, infospeed, replicas, keepalive);
+    if (active(somewhere::fastest{})) reporter(CALL, somewhere::fastest{}, formula, diameter, infospeed);
+    if (active(somewhere::delta_fastest{})) reporter(CALL, somewhere::delta_fastest{}, formula, diameter, infospeed, refresh);
+    if (active(somewhere::tailored_fastest{})) reporter(CALL, somewhere::tailored_fastest{}, formula, diameter, infospeed,
+             node.storage(link_mean<somewhere::tailored_fastest>{}), node.storage(link_max<somewhere::tailored_fastest>{}));
+    if (active(somewhere::sparse_fastest{})) reporter(CALL, somewhere::sparse_fastest{}, formula, diameter, infospeed);
+    if (active(somewhere::hierarchical_fastest{})) reporter(CALL, somewhere::hierarchical_fastest{}, formula, diameter, infospeed);
+    if (active(somewhere::timestamp_gossip{})) reporter(CALL, somewhere::timestamp_gossip{}, formula, diameter, infospeed);
+    if (active(somewhere::hybrid{})) reporter(CALL, somewhere::hybrid{}, formula, diameter, infospeed, budget);
+    std::bitset<few_props> few = propositions<few_props>(node.uid, somewhere_f);
+    std::bitset<many_props> many = propositions<many_props>(node.uid, somewhere_f);
+    if (active(somewhere::multi_baseline<few_props>{})) reporter(CALL, somewhere::multi_baseline<few_props>{}, few, diameter);
+    if (active(somewhere::multi_baseline<many_props>{})) reporter(CALL, somewhere::multi_baseline<many_props>{}, many, diameter);
+    if (active(somewhere::multi_replicated<few_props>{})) reporter(CALL, somewhere::multi_replicated<few_props>{}, few, diameter, infospeed, replicas);
+    if (active(somewhere::multi_replicated<many_props>{})) reporter(CALL, somewhere::multi_replicated<many_props>{}, many, diameter, infospeed, replicas);
+    if (active(somewhere::multi_fastest<few_props>{})) reporter(CALL, somewhere::multi_fastest<few_props>{}, few, diameter, infospeed);
+    if (active(somewhere::multi_fastest<many_props>{})) reporter(CALL, somewhere::multi_fastest<many_props>{}, many, diameter, infospeed);
+
+    // outside of the inner disk, so that the dual somewhere computations differ from the ones above
+    reporter(CALL, everywhere::oracle{}, not inner, not somewhere_f);
+    if (active(everywhere::baseline{})) reporter(CALL, everywhere::baseline{}, not inner, diameter);
+    if (active(everywhere::fastest{})) reporter(CALL, everywhere::fastest{}, not inner, diameter, infospeed);
+    reporter(CALL, nearby::oracle{}, formula, somewhere_f and source_dist < comm);
+    if (active(nearby::baseline{})) reporter(CALL, nearby::baseline{}, formula);
+    reporter(CALL, reach::oracle{}, inner, formula, reachable(node, is_inner, is_formula));
+    if (active(reach::baseline{})) reporter(CALL, reach::baseline{}, inner, formula, diameter);
+    if (active(reach::fastest{})) reporter(CALL, reach::fastest{}, inner, formula, diameter, infospeed);
+    reporter(CALL, surrounded::oracle{}, inner, ring, inner and not reachable(node, [&](device_t i, vec<dim> const& p){
+        return not is_ring(i, p);
+    }, [&](device_t i, vec<dim> const& p){
+        return not is_inner(i, p) and not is_ring(i, p);
+    }));
+    if (active(surrounded::baseline{})) reporter(CALL, surrounded::baseline{}, inner, ring, diameter);
+    if (active(surrounded::fastest{})) reporter(CALL, surrounded::fastest{}, inner, ring, diameter, infospeed);
 
     // usage of node storage
     node.storage(node_size{}) = formula ? 20 : 10;
@@ -117,20 +352,81 @@ MAIN() {
 }
 //! @brief Export types used by the main function.
 FUN_EXPORT main_t = export_list<
-    rectangle_walk_t<2>, 
+    rectangle_walk_t<2>,
+    propagation_speed_t,
+    shared_speed_t,
     reporter_t<somewhere::oracle>,
     reporter_t<somewhere::baseline>,
+    reporter_t<somewhere::saturating_baseline<max_diameter>>,
+    reporter_t<somewhere::lazy_baseline>,
     reporter_t<somewhere::knowledge_free>,
     reporter_t<somewhere::replicated>,
-    reporter_t<somewhere::fastest>
+    reporter_t<somewhere::split_replicated>,
+    reporter_t<somewhere::bitwise_replicated>,
+    reporter_t<somewhere::lazy_bitwise_replicated>,
+    reporter_t<somewhere::fastest>,
+    reporter_t<somewhere::delta_fastest>,
+    reporter_t<somewhere::tailored_fastest>,
+    reporter_t<somewhere::sparse_fastest>,
+    reporter_t<somewhere::hierarchical_fastest>,
+    reporter_t<somewhere::timestamp_gossip>,
+    reporter_t<somewhere::hybrid>,
+    reporter_t<somewhere::multi_baseline<few_props>>,
+    reporter_t<somewhere::multi_baseline<many_props>>,
+    reporter_t<somewhere::multi_replicated<few_props>>,
+    reporter_t<somewhere::multi_replicated<many_props>>,
+    reporter_t<somewhere::multi_fastest<few_props>>,
+    reporter_t<somewhere::multi_fastest<many_props>>,
+    reporter_t<everywhere::oracle>,
+    reporter_t<everywhere::baseline>,
+    reporter_t<everywhere::fastest>,
+    reporter_t<nearby::oracle>,
+    reporter_t<nearby::baseline>,
+    reporter_t<reach::oracle>,
+    reporter_t<reach::baseline>,
+    reporter_t<reach::fastest>,
+    reporter_t<surrounded::oracle>,
+    reporter_t<surrounded::baseline>,
+    reporter_t<surrounded::fastest>
 >;
 //! @brief Storage tags and types used by the main function.
 FUN_EXPORT main_s = storage_list<
     reporter_s<somewhere::oracle>,
     reporter_s<somewhere::baseline>,
+    reporter_s<somewhere::saturating_baseline<max_diameter>>,
+    reporter_s<somewhere::lazy_baseline>,
     reporter_s<somewhere::knowledge_free>,
     reporter_s<somewhere::replicated>,
+    reporter_s<somewhere::split_replicated>,
+    reporter_s<somewhere::bitwise_replicated>,
+    reporter_s<somewhere::lazy_bitwise_replicated>,
     reporter_s<somewhere::fastest>,
+    reporter_s<somewhere::delta_fastest>,
+    reporter_s<somewhere::tailored_fastest>,
+    tags::link_mean<somewhere::tailored_fastest>,   double,
+    tags::link_max<somewhere::tailored_fastest>,    size_t,
+    reporter_s<somewhere::sparse_fastest>,
+    reporter_s<somewhere::hierarchical_fastest>,
+    reporter_s<somewhere::timestamp_gossip>,
+    reporter_s<somewhere::hybrid>,
+    reporter_s<somewhere::multi_baseline<few_props>>,
+    reporter_s<somewhere::multi_baseline<many_props>>,
+    reporter_s<somewhere::multi_replicated<few_props>>,
+    reporter_s<somewhere::multi_replicated<many_props>>,
+    reporter_s<somewhere::multi_fastest<few_props>>,
+    reporter_s<somewhere::multi_fastest<many_props>>,
+    reporter_s<everywhere::oracle>,
+    reporter_s<everywhere::baseline>,
+    reporter_s<everywhere::fastest>,
+    reporter_s<nearby::oracle>,
+    reporter_s<nearby::baseline>,
+    reporter_s<reach::oracle>,
+    reporter_s<reach::baseline>,
+    reporter_s<reach::fastest>,
+    reporter_s<surrounded::oracle>,
+    reporter_s<surrounded::baseline>,
+    reporter_s<surrounded::fastest>,
+    tags::msg_mark,             size_t,
     tags::node_color,           color,
     tags::node_shape,           shape,
     tags::node_size,            double
@@ -177,20 +473,54 @@ template <typename T>
 using algorithm_aggr = storage_list<
     value<T>,          aggregator::mean<double>,
     error<T>,          aggregator::mean<double>,
-    msg_size<T>,       aggregator::mean<double>
+    msg_size<T>,       aggregator::mean<double>,
+    msg_sent<T>,       aggregator::mean<double>,
+    run_time<T>,       aggregator::mean<double>
 >;
 using aggregator_t = storage_list<
     algorithm_aggr<coordination::somewhere::oracle>,
     algorithm_aggr<coordination::somewhere::baseline>,
+    algorithm_aggr<coordination::somewhere::saturating_baseline<max_diameter>>,
+    algorithm_aggr<coordination::somewhere::lazy_baseline>,
     algorithm_aggr<coordination::somewhere::knowledge_free>,
     algorithm_aggr<coordination::somewhere::replicated>,
-    algorithm_aggr<coordination::somewhere::fastest>
+    algorithm_aggr<coordination::somewhere::split_replicated>,
+    algorithm_aggr<coordination::somewhere::bitwise_replicated>,
+    algorithm_aggr<coordination::somewhere::lazy_bitwise_replicated>,
+    algorithm_aggr<coordination::somewhere::fastest>,
+    algorithm_aggr<coordination::somewhere::delta_fastest>,
+    algorithm_aggr<coordination::somewhere::tailored_fastest>,
+    storage_list<
+        link_mean<coordination::somewhere::tailored_fastest>,   aggregator::mean<double>,
+        link_max<coordination::somewhere::tailored_fastest>,    aggregator::max<size_t>
+    >,
+    algorithm_aggr<coordination::somewhere::sparse_fastest>,
+    algorithm_aggr<coordination::somewhere::hierarchical_fastest>,
+    algorithm_aggr<coordination::somewhere::timestamp_gossip>,
+    algorithm_aggr<coordination::somewhere::hybrid>,
+    algorithm_aggr<coordination::somewhere::multi_baseline<few_props>>,
+    algorithm_aggr<coordination::somewhere::multi_baseline<many_props>>,
+    algorithm_aggr<coordination::somewhere::multi_replicated<few_props>>,
+    algorithm_aggr<coordination::somewhere::multi_replicated<many_props>>,
+    algorithm_aggr<coordination::somewhere::multi_fastest<few_props>>,
+    algorithm_aggr<coordination::somewhere::multi_fastest<many_props>>,
+    algorithm_aggr<coordination::everywhere::oracle>,
+    algorithm_aggr<coordination::everywhere::baseline>,
+    algorithm_aggr<coordination::everywhere::fastest>,
+    algorithm_aggr<coordination::nearby::oracle>,
+    algorithm_aggr<coordination::nearby::baseline>,
+    algorithm_aggr<coordination::reach::oracle>,
+    algorithm_aggr<coordination::reach::baseline>,
+    algorithm_aggr<coordination::reach::fastest>,
+    algorithm_aggr<coordination::surrounded::oracle>,
+    algorithm_aggr<coordination::surrounded::baseline>,
+    algorithm_aggr<coordination::surrounded::fastest>
 >;
 //! @brief The aggregator to be used on logging rows for plotting.
 using row_aggregator_t = common::type_sequence<aggregator::mean<double>>;
-//! @brief The logged values to be shown in plots as lines given unit U.
-template <template<class> class U>
-using points_t = plot::values< aggregator_t, row_aggregator_t, plot::unit<U> >;
+//! @brief The logged values to be shown in plots as lines given unit U (among those of aggregators A).
+template <template<class> class U, typename A = aggregator_t>
+using points_t = plot::values< A, row_aggregator_t, plot::unit<U> >;
 //! @brief A generic plot given unit U, split tag S and filters Fs.
 template <template<class> class U, typename S, typename... Fs>
 using gen_plot_t = plot::split<
@@ -202,20 +532,46 @@ template <typename S, typename... Fs>
 using plot_row_t = plot::split<common::type_sequence<>, plot::join<
     gen_plot_t<value,S,Fs...>,
     gen_plot_t<error,S,Fs...>,
-    gen_plot_t<msg_size,S,Fs...>
+    gen_plot_t<msg_size,S,Fs...>,
+    gen_plot_t<msg_sent,S,Fs...>,
+    gen_plot_t<run_time,S,Fs...>
 >>;
-//! @brief A plot of the logged values by time for tvar,dens,hops,speed = 10 (default values).
-using time_plot_t = plot_row_t<plot::time, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>>;
+//! @brief A plot of the logged values by time for tvar,dens,hops,speed = 10, replicas = 3, infospeed = 2, lane = 0 (default values).
+using time_plot_t = plot_row_t<plot::time, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
 //! @brief A plot of the logged values by tvar for times >= true_time (after the first formula switch).
-using tvar_plot_t = plot_row_t<tvar, plot::time, filter::above<true_time>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>>;
+using tvar_plot_t = plot_row_t<tvar, plot::time, filter::above<true_time>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
 //! @brief A plot of the logged values by dens for times >= true_time (after the first formula switch).
-using dens_plot_t = plot_row_t<dens, plot::time, filter::above<true_time>, tvar, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>>;
+using dens_plot_t = plot_row_t<dens, plot::time, filter::above<true_time>, tvar, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
 //! @brief A plot of the logged values by hops for times >= true_time (after the first formula switch).
-using hops_plot_t = plot_row_t<hops, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, speed, filter::equal<10>>;
+using hops_plot_t = plot_row_t<hops, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
 //! @brief A plot of the logged values by speed for times >= true_time (after the first formula switch).
-using speed_plot_t = plot_row_t<speed, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>>;
+using speed_plot_t = plot_row_t<speed, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
+//! @brief A plot of the logged values by replicas for times >= true_time (after the first formula switch).
+using replicas_plot_t = plot_row_t<replicas, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, infospeed, filter::equal<2>, lane, filter::equal<0>>;
+//! @brief A plot of the logged values by infospeed for times >= true_time (after the first formula switch).
+using infospeed_plot_t = plot_row_t<infospeed, plot::time, filter::above<true_time>, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, lane, filter::equal<0>>;
+//! @brief A row of plots by time of the values logged for implementation A only, given filters Fs.
+template <typename A, typename... Fs>
+using algorithm_row_t = plot::split<common::type_sequence<>, plot::join<
+    plot::split<plot::time, plot::filter< Fs..., points_t<value, algorithm_aggr<A>> >>,
+    plot::split<plot::time, plot::filter< Fs..., points_t<error, algorithm_aggr<A>> >>,
+    plot::split<plot::time, plot::filter< Fs..., points_t<msg_size, algorithm_aggr<A>> >>,
+    plot::split<plot::time, plot::filter< Fs..., points_t<msg_sent, algorithm_aggr<A>> >>,
+    plot::split<plot::time, plot::filter< Fs..., points_t<run_time, algorithm_aggr<A>> >>
+>>;
+//! @brief Rows of plots by time for every lane k, of the implementation running alone in it (for default values of the other factors).
+template <typename K, typename As>
+struct lane_plots;
+template <size_t... ks, typename... As>
+struct lane_plots<std::index_sequence<ks...>, common::type_sequence<As...>> {
+    using type = plot::join<algorithm_row_t<As, lane, filter::equal<ks+1>, tvar, filter::equal<10>, dens, filter::equal<10>, hops, filter::equal<10>, speed, filter::equal<10>, replicas, filter::equal<3>, infospeed, filter::equal<2>>...>;
+};
+//! @brief The plots of every implementation running alone in its lane.
+using lane_plot_t = typename lane_plots<std::make_index_sequence<lanes>, lane_algorithms>::type;
 //! @brief Combining the plots into a single row.
-using plot_t = plot::join<time_plot_t, tvar_plot_t, dens_plot_t, hops_plot_t, speed_plot_t>;
+using plot_t = plot::join<time_plot_t, tvar_plot_t, dens_plot_t, hops_plot_t, speed_plot_t, replicas_plot_t, infospeed_plot_t, lane_plot_t>;
+//! @brief The plotter object type, collecting rows into plot_t (possibly from parallel runs).
+using plotter_t = runner::recorder<plot_t>;
 
 // computes side length from hops
 struct side_formula {
@@ -234,6 +590,47 @@ struct device_formula {
         return d*s*s/(3.141592653589793*comm*comm) + 0.5;
     }
 };
+// the relative cost of a round of an implementation, given device number and dens (neighbours times entries shared)
+template <typename F>
+struct cost_factor {
+    static double of(double, double d) {
+        return d;
+    }
+};
+// the relative cost of a round of an implementation sharing a netstate (neighbours times devices)
+struct netstate_cost {
+    static double of(double n, double d) {
+        return d * n;
+    }
+};
+template <> struct cost_factor<coordination::somewhere::fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::delta_fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::tailored_fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::sparse_fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::hierarchical_fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::timestamp_gossip> : netstate_cost {};
+template <> struct cost_factor<coordination::somewhere::hybrid> : netstate_cost {};
+template <size_t N> struct cost_factor<coordination::somewhere::multi_fastest<N>> : netstate_cost {};
+template <> struct cost_factor<coordination::everywhere::fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::reach::fastest> : netstate_cost {};
+template <> struct cost_factor<coordination::surrounded::fastest> : netstate_cost {};
+// the relative cost of a round of the implementations active in a lane, plus the simulation and the oracles
+template <typename... As>
+double lane_cost(size_t lane, double n, double d, common::type_sequence<As...>) {
+    double c = d;
+    size_t k = 0;
+    ((++k, c += lane == 0 or lane == k ? cost_factor<As>::of(n, d) : 0), ...);
+    return c;
+}
+// estimates the cost of a run from device number, dens and lane (devices times the cost of their rounds)
+struct cost_formula {
+    template <typename T>
+    double operator()(T const& x) const {
+        double n = common::get<devices>(x);
+        double d = common::get<dens>(x);
+        return n * lane_cost(common::get<lane>(x), n, d, lane_algorithms{});
+    }
+};
 
 //! @brief The general simulation options.
 DECLARE_OPTIONS(list,
@@ -251,7 +648,10 @@ DECLARE_OPTIONS(list,
     net_store<     // the contents of the net storage
         side,       double,
         hops,       double,
-        speed,      double
+        speed,      double,
+        replicas,   size_t,
+        infospeed,  double,
+        lane,       size_t
     >,
     aggregators<aggregator_t>,  // the tags and corresponding aggregators to be logged
     init<
@@ -262,9 +662,12 @@ DECLARE_OPTIONS(list,
         tvar,   double,
         dens,   double,
         hops,   double,
-        speed,  double
+        speed,  double,
+        replicas,   double,
+        infospeed,  double,
+        lane,       double
     >,
-    plot_type<plot_t>, // the plot description to be used
+    plot_type<plotter_t>, // the plot description to be used
     dimension<dim>, // dimensionality of the space
     connector<connect::fixed<comm, 1, dim>>, // connection allowed within a fixed comm range
     shape_tag<node_shape>, // the shape of a node is read from this tag in the store
@@ -8,6 +8,10 @@
 #ifndef FCPP_SOMEWHERE_H_
 #define FCPP_SOMEWHERE_H_
 
+#include <bitset>
+#include <ios>
+#include <type_traits>
+
 #include "lib/coordination/election.hpp"
 #include "lib/coordination/past_ctl.hpp"
 #include "lib/coordination/slcs.hpp"
@@ -21,6 +25,28 @@ namespace fcpp {
 //! @brief Namespace containing the libraries of coordination routines.
 namespace coordination {
 
+/**
+ * A clock counting the intervals between replicas, agreed across the network and never moving backwards.
+ *
+ * As shared_clock, each device takes the maximum among its own clock and those of neighbours (aged by their lag),
+ * but the clock advances in units of the current interval: a change of interval only changes its pace from then on,
+ * instead of rescaling the whole elapsed time, so that replica epochs are neither skipped nor reused.
+ *
+ * @param t The current interval between replica spawning.
+ */
+FUN real_t replica_clock(ARGS, times_t t) { CODE
+    return nbr(CALL, real_t(0), [&](field<real_t> n){
+        times_t dt = node.current_time() - node.previous_time();
+        real_t own = fcpp::details::self(n, node.uid) + (std::isfinite(dt) ? dt / t : 0);
+        real_t c = max_hood(CALL, map_hood(CALL, [&](real_t x, times_t lag){
+            return x + lag / t;
+        }, n, node.nbr_lag()), own);
+        return make_tuple(c, c);
+    });
+}
+//! @brief Export list for replica_clock.
+FUN_EXPORT replica_clock_t = export_list<real_t>;
+
 /**
  * Generic algorithm replicator, returning the value of the oldest
  * replica currently running.
@@ -30,7 +56,7 @@ namespace coordination {
  * @param t   The interval between replica spawning.
  */
 GEN(F) auto replicate(ARGS, F fun, size_t n, times_t t) { CODE
-    size_t now = shared_clock(CALL) / t;
+    size_t now = replica_clock(CALL, t);
     auto res = spawn(CALL, [&](size_t i){
         return make_tuple(fun(), i > now - n);
     }, common::option<size_t, true>{now});
@@ -38,7 +64,166 @@ GEN(F) auto replicate(ARGS, F fun, size_t n, times_t t) { CODE
     return res[now];
 }
 //! @brief Export list for replicate.
-FUN_EXPORT replicate_t = export_list<spawn_t<size_t, bool>, shared_clock_t>;
+FUN_EXPORT replicate_t = export_list<spawn_t<size_t, bool>, replica_clock_t>;
+
+/**
+ * Generic algorithm replicator through split, returning the value of the oldest
+ * replica currently running (or of the first one, before `n` replicas have been started).
+ *
+ * Every device runs all live replicas from a single `split` call, keyed by their starting epoch,
+ * instead of through a process map. The results must be default-constructible.
+ *
+ * @param fun The aggregate code to replicate (without arguments).
+ * @param n   The number of replicas.
+ * @param t   The interval between replica spawning.
+ */
+GEN(F) auto split_replicate(ARGS, F fun, size_t n, times_t t) { CODE
+    size_t now = replica_clock(CALL, t);
+    size_t first = now < n ? 0 : now + 1 - n;
+    decltype(fun()) r{};
+    for (size_t k = first; k <= now; ++k) {
+        auto x = split(CALL, k, fun);
+        if (k == first) r = std::move(x);
+    }
+    return r;
+}
+//! @brief Export list for split_replicate.
+FUN_EXPORT split_replicate_t = export_list<replica_clock_t>;
+
+
+/**
+ * Estimates the speed of information propagation (in hops per second).
+ *
+ * Information crosses a hop when the receiver fires its next round, that is, after the lag
+ * of the receiver's neighbour data. The estimate is the inverse of the average lag, smoothed
+ * over rounds.
+ *
+ * @param guess The speed returned before any neighbour data has been observed.
+ */
+FUN real_t propagation_speed(ARGS, real_t guess) { CODE
+    size_t k = count_hood(CALL) - 1;
+    times_t lag = k > 0 ? sum_hood(CALL, node.nbr_lag(), times_t(0)) / k : 0;
+    times_t avg = old(CALL, times_t(0), [&](times_t prev){
+        times_t r = k == 0 ? prev : prev > 0 ? prev + (lag - prev) / 8 : lag;
+        return make_tuple(r, r);
+    });
+    return avg > 0 ? 1 / avg : guess;
+}
+//! @brief Export list for propagation_speed.
+FUN_EXPORT propagation_speed_t = export_list<times_t>;
+
+/**
+ * Agrees on a speed of information propagation across the network, from local estimates.
+ *
+ * Time is divided into windows of given length (equal on every device). Within each window, the minimum
+ * estimate is gossiped, and the result is the minimum gossiped in the previous window (the first estimate
+ * in the first window), frozen for the whole window. Thus devices agree on the result, provided that
+ * the gossip spans the network within a window, and periods derived from it only change between windows.
+ * The minimum is chosen as it is conservative for periods which should span the diameter.
+ *
+ * @param estimate The local estimate of the speed (in hops per second).
+ * @param window   The length of windows (in seconds).
+ */
+FUN real_t shared_speed(ARGS, real_t estimate, times_t window) { CODE
+    using state_t = tuple<size_t, real_t, real_t>;
+    size_t w = node.current_time() / window;
+    return nbr(CALL, state_t(w, estimate, estimate), [&](field<state_t> n){
+        state_t const& own = fcpp::details::self(n, node.uid);
+        std::vector<state_t> const& vals = fcpp::details::get_vals(n);
+        bool fresh = get<0>(own) != w;
+        real_t low = estimate, frozen = fresh ? INF : get<2>(own);
+        // skips the default value at index zero
+        for (size_t i = 1; i < vals.size(); ++i) {
+            if (get<0>(vals[i]) == w) low = std::min(low, get<1>(vals[i]));
+            if (fresh and get<0>(vals[i]) + 1 == w) frozen = std::min(frozen, get<1>(vals[i]));
+            if (fresh and get<0>(vals[i]) == w) frozen = std::min(frozen, get<2>(vals[i]));
+        }
+        if (frozen == INF) frozen = estimate;
+        return make_tuple(frozen, state_t(w, low, frozen));
+    });
+}
+//! @brief Export list for shared_speed.
+FUN_EXPORT shared_speed_t = export_list<tuple<size_t, real_t, real_t>>;
+
+
+/**
+ * Exchanges values with neighbours as nbr, but suppressing the values unchanged since their last sending.
+ *
+ * Each neighbour caches the latest value received, so that the field passed to `fun` holds the latest
+ * values actually sent. A value is sent anyway if `keepalive` seconds passed since its last sending,
+ * so that new neighbours receive it within that time (which should be below the retain time of messages).
+ *
+ * @param init      The value assumed for neighbours which never sent a value.
+ * @param fun       The function from the field of neighbour values to the result and the value to send.
+ * @param keepalive The maximum interval between sendings.
+ * @param sent      Set to whether the value was actually sent.
+ */
+GEN(T, G) auto lazy_nbr(ARGS, T const& init, G&& fun, times_t keepalive, bool& sent) { CODE
+    using state_t = tuple<T, times_t, field<T>>;
+    return old(CALL, make_tuple(init, times_t(-INF), field<T>(init)), [&](state_t s){
+        auto r = nbr(CALL, std::vector<T>{}, [&](field<std::vector<T>> n){
+            get<2>(s) = map_hood(CALL, [](std::vector<T> const& m, T const& c){
+                return m.empty() ? c : m[0];
+            }, n, get<2>(s));
+            auto t = fun(get<2>(s));
+            sent = get<1>(t) != get<0>(s) or node.current_time() - get<1>(s) >= keepalive;
+            std::vector<T> out;
+            if (sent) {
+                out.push_back(get<1>(t));
+                get<0>(s) = get<1>(t);
+                get<1>(s) = node.current_time();
+            }
+            return make_tuple(get<0>(t), std::move(out));
+        });
+        return make_tuple(r, std::move(s));
+    });
+}
+//! @brief Export list for lazy_nbr.
+GEN_EXPORT(T) lazy_nbr_t = export_list<tuple<T, times_t, field<T>>, std::vector<T>>;
+
+
+/**
+ * A round of a hop-count gradient saturating at a given maximum, to be exchanged through nbr (or lazy_nbr).
+ *
+ * @param n       The hop counts of neighbours.
+ * @param source  Whether the device is a source (with zero hops).
+ * @param through Whether the gradient may pass through the device (otherwise it has the maximum hops).
+ * @param d       The maximum hop count, meaning that no source is reachable.
+ * @return Whether a source is reachable, and the hop count to be shared.
+ */
+GEN(H) tuple<bool, H> saturating_hops(ARGS, field<H> const& n, bool source, bool through, H d) { CODE
+    H h = source ? H(0) : through ? H(std::min<size_t>(min_hood(CALL, n, d) + size_t(1), d)) : d;
+    return make_tuple(h < d, h);
+}
+
+
+/**
+ * A round of the EP past-CTL operator with all replicas packed into a single word, to be exchanged through nbr (or lazy_nbr).
+ *
+ * Replica `k` starts at epoch `k` of a replica_clock, and in epoch `e` (the latest replica started) it is stored
+ * in the bit `e-k` of the mask. The epoch is the maximum known by neighbours, whose masks are shifted
+ * to the current epoch and merged by bitwise or. Supports up to 64 replicas.
+ *
+ * @param n        The epochs and masks of neighbours.
+ * @param f        The formula on the device.
+ * @param epoch    The current epoch of the device.
+ * @param replicas The number of replicas.
+ * @return The value of the oldest replica, and the epoch and mask to be shared.
+ */
+FUN tuple<bool, tuple<size_t, uint64_t>> bitwise_replicas(ARGS, field<tuple<size_t, uint64_t>> const& n, bool f, size_t epoch, size_t replicas) { CODE
+    uint64_t live = replicas < 64 ? (uint64_t(1) << replicas) - 1 : ~uint64_t(0);
+    size_t e = std::max(epoch, get<0>(fold_hood(CALL, [](tuple<size_t, uint64_t> const& x, tuple<size_t, uint64_t> const& y){
+        return std::max(x, y);
+    }, n)));
+    uint64_t mask = fold_hood(CALL, [](uint64_t x, uint64_t y){
+        return x | y;
+    }, map_hood(CALL, [&](tuple<size_t, uint64_t> const& x){
+        return e - get<0>(x) < 64 ? get<1>(x) << (e - get<0>(x)) : uint64_t(0);
+    }, n));
+    if (f) mask |= live;
+    mask &= live;
+    return make_tuple(((mask >> std::min(replicas-1, e)) & 1) > 0, make_tuple(e, mask));
+}
 
 
 //! @brief Grouping different somewhere implementations.
@@ -61,12 +246,48 @@ struct baseline {
     FUN_EXPORT export_t = export_list<abf_hops_t>;
 };
 
-//! @brief Knowledge-free implementation.
+/**
+ * @brief Baseline implementation with hop counts saturating at the diameter.
+ *
+ * Hop counts are stored in the smallest unsigned type holding the maximum diameter M,
+ * and the results coincide with those of the baseline for diameters up to M.
+ */
+template <size_t M>
+struct saturating_baseline {
+    //! @brief The type of hop counts.
+    using hops_type = std::conditional_t<M < (1<<8), uint8_t, std::conditional_t<M < (1<<16), uint16_t, uint32_t>>;
+
+    FUN bool operator()(ARGS, bool f, hops_t diameter) const { CODE
+        hops_type d = std::min<size_t>(diameter, M);
+        return nbr(CALL, d, [&](field<hops_type> n){
+            return saturating_hops(CALL, n, f, true, d);
+        });
+    }
+    FUN_EXPORT export_t = export_list<hops_type>;
+};
+
+//! @brief Baseline implementation with hop counts saturating at the diameter, sent only when changed (or every keepalive seconds).
+struct lazy_baseline {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, times_t keepalive, bool& sent) const { CODE
+        return lazy_nbr(CALL, diameter, [&](field<hops_t> n){
+            return saturating_hops(CALL, n, f, true, diameter);
+        }, keepalive, sent);
+    }
+    FUN_EXPORT export_t = export_list<lazy_nbr_t<hops_t>>;
+};
+
+/**
+ * @brief Knowledge-free implementation.
+ *
+ * The elected key has the negated formula folded into the top bit of the device identifier,
+ * which preserves the order of the pair (requiring identifiers not to use the top bit).
+ */
 struct knowledge_free {
     FUN bool operator()(ARGS, bool f) const { CODE
-        return not get<0>(wave_election(CALL, make_tuple(not f, node.uid)));
+        constexpr device_t top = device_t(1) << (std::numeric_limits<device_t>::digits - 1);
+        return (wave_election(CALL, f ? node.uid : node.uid | top) & top) == 0;
     }
-    FUN_EXPORT export_t = export_list<wave_election_t<tuple<bool,device_t>>>;
+    FUN_EXPORT export_t = export_list<wave_election_t<device_t>>;
 };
 
 //! @brief Implementation by replicating the EP past-CTL operator.
@@ -79,60 +300,918 @@ struct replicated {
     FUN_EXPORT export_t = export_list<replicate_t, past_ctl_t>;
 };
 
-//! @brief Models a view of a data for all devices of a network.
-struct netstate {
+//! @brief Implementation by replicating the EP past-CTL operator, with replicas run through split.
+struct split_replicated {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, size_t replicas) const { CODE
+        return split_replicate(CALL, [&](){
+            return logic::EP(CALL, f);
+        }, replicas, diameter / infospeed / (replicas-1));
+    }
+    FUN_EXPORT export_t = export_list<split_replicate_t, past_ctl_t>;
+};
+
+//! @brief Implementation replicating the EP past-CTL operator, with all replicas packed into a single word (see bitwise_replicas).
+struct bitwise_replicated {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, size_t replicas) const { CODE
+        size_t epoch = replica_clock(CALL, diameter / infospeed / (replicas-1));
+        return nbr(CALL, make_tuple(size_t(0), uint64_t(0)), [&](field<tuple<size_t, uint64_t>> n){
+            return bitwise_replicas(CALL, n, f, epoch, replicas);
+        });
+    }
+    FUN_EXPORT export_t = export_list<replica_clock_t, tuple<size_t, uint64_t>>;
+};
+
+//! @brief Bitwise replicated implementation, sending epoch and mask only when changed (or every keepalive seconds).
+struct lazy_bitwise_replicated {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, size_t replicas, times_t keepalive, bool& sent) const { CODE
+        size_t epoch = replica_clock(CALL, diameter / infospeed / (replicas-1));
+        return lazy_nbr(CALL, make_tuple(size_t(0), uint64_t(0)), [&](field<tuple<size_t, uint64_t>> n){
+            return bitwise_replicas(CALL, n, f, epoch, replicas);
+        }, keepalive, sent);
+    }
+    FUN_EXPORT export_t = export_list<replica_clock_t, lazy_nbr_t<tuple<size_t, uint64_t>>>;
+};
+
+//! @brief Precision of netstate timestamps in messages (a small fraction of the round period).
+#ifndef FCPP_NETSTATE_PRECISION
+#define FCPP_NETSTATE_PRECISION 0.01
+#endif
+
+/**
+ * @brief Compact serialisation of netstate entries.
+ *
+ * The entries are preceded by their number and by a reference time (the latest timestamp among them).
+ * Each entry is then encoded as two varints: the difference from the previous device identifier,
+ * and the age with respect to the reference time in multiples of FCPP_NETSTATE_PRECISION, shifted
+ * to make room for the truth value in the lowest bit (or followed by a third varint, for words
+ * of multiple truth values). Timestamps are rounded down, so that
+ * the deserialised ones are older by less than FCPP_NETSTATE_PRECISION. Entries with infinite
+ * timestamps are equivalent to missing ones, and are not serialised.
+ */
+namespace compact {
+    //! @brief Writes an unsigned integer as a varint.
+    template <typename S>
+    void write_varint(S& s, uint64_t x) {
+        while (x >= 128) {
+            s << uint8_t(x | 128);
+            x >>= 7;
+        }
+        s << uint8_t(x);
+    }
+
+    //! @brief Fails a stream on malformed input (setting its fail bit if it has one, throwing otherwise).
+    template <typename S>
+    void fail(S& s) {
+        if constexpr (std::is_base_of<std::ios_base, S>::value) s.setstate(std::ios_base::failbit);
+        else throw std::ios_base::failure("compact: malformed varint");
+    }
+
+    //! @brief Whether a stream has failed (never for streams without a fail bit, which throw instead).
+    template <typename S>
+    bool failed(S& s) {
+        if constexpr (std::is_base_of<std::ios_base, S>::value) return s.fail();
+        else return false;
+    }
+
+    //! @brief Reads an unsigned integer written as a varint, failing the stream after 10 bytes (the longest 64-bit varint).
+    template <typename S>
+    uint64_t read_varint(S& s) {
+        uint64_t x = 0;
+        for (int shift = 0; shift < 70; shift += 7) {
+            uint8_t b;
+            s >> b;
+            if (failed(s)) return 0;
+            x |= uint64_t(b & 127) << shift;
+            if (b < 128) return x;
+        }
+        fail(s);
+        return 0;
+    }
+
+    //! @brief Writes an age together with a truth value.
+    template <typename S>
+    void write_entry(S& s, uint64_t age, bool val) {
+        write_varint(s, age << 1 | val);
+    }
+
+    //! @brief Writes an age together with a word of truth values.
+    template <typename S>
+    void write_entry(S& s, uint64_t age, uint64_t vals) {
+        write_varint(s, age);
+        write_varint(s, vals);
+    }
+
+    //! @brief Reads an age together with a truth value.
+    template <typename S>
+    uint64_t read_entry(S& s, bool& val) {
+        uint64_t x = read_varint(s);
+        val = (x & 1) > 0;
+        return x >> 1;
+    }
+
+    //! @brief Reads an age together with a word of truth values.
+    template <typename S>
+    uint64_t read_entry(S& s, uint64_t& vals) {
+        uint64_t age = read_varint(s);
+        vals = read_varint(s);
+        return age;
+    }
+
+    //! @brief Writes `n` entries, given as a function from indices to device, timestamp and truth value(s).
+    template <typename S, typename G>
+    S& write(S& s, size_t n, G&& entry) {
+        size_t count = 0;
+        times_t ref = -INF;
+        for (size_t i = 0; i < n; ++i) {
+            times_t t = get<1>(entry(i));
+            if (std::isfinite(t)) {
+                ++count;
+                ref = std::max(ref, t);
+            }
+        }
+        write_varint(s, count);
+        if (count == 0) return s;
+        s << ref;
+        device_t prev = 0;
+        for (size_t i = 0; i < n; ++i) {
+            auto e = entry(i);
+            if (not std::isfinite(get<1>(e))) continue;
+            real_t age = std::ceil((ref - get<1>(e)) / FCPP_NETSTATE_PRECISION);
+            write_varint(s, get<0>(e) - prev);
+            write_entry(s, uint64_t(std::min(age, real_t(uint64_t(1) << 62))), get<2>(e));
+            prev = get<0>(e);
+        }
+        return s;
+    }
+
+    //! @brief Reads entries with truth value(s) of type V, passing them in increasing device order to a given function.
+    template <typename V, typename S, typename G>
+    S& read(S& s, G&& insert) {
+        size_t count = read_varint(s);
+        if (count == 0) return s;
+        times_t ref;
+        s >> ref;
+        device_t id = 0;
+        for (size_t i = 0; i < count and not failed(s); ++i) {
+            id += read_varint(s);
+            V val;
+            uint64_t age = read_entry(s, val);
+            if (failed(s)) break;
+            insert(id, ref - age * FCPP_NETSTATE_PRECISION, val);
+        }
+        return s;
+    }
+}
+
+/**
+ * @brief Output archive computing the size of serialised data, without writing it.
+ *
+ * Arithmetic values are counted by their size, and other values through their serialize member function
+ * (as netstates), so that the result coincides with the size of the same data written to a common::osstream.
+ */
+class size_counter {
+  public:
+    //! @brief Counts an arithmetic value, or a value with a serialize member function.
+    template <typename T>
+    size_counter& operator<<(T const& x) {
+        if constexpr (std::is_arithmetic<T>::value) m_size += sizeof(T);
+        else x.serialize(*this);
+        return *this;
+    }
+
+    //! @brief The number of bytes counted so far.
+    size_t size() const {
+        return m_size;
+    }
+
+  private:
+    //! @brief The number of bytes counted so far.
+    size_t m_size = 0;
+};
+
+/**
+ * @brief Models a view of a data for all devices of a network, stored as a field.
+ *
+ * The latest timestamp of a true entry is maintained along with the data, so that value queries do not scan it.
+ * It is recomputed by a full scan when the device holding it turns false, and after merges, deltas and
+ * deserialisation, so that a round of fastest (which merges the neighbours' netstates) is still linear in the devices.
+ */
+struct field_netstate {
     //! @brief Default constructor.
-    netstate() : data(make_tuple(-INF, false)) {}
+    field_netstate() : data(make_tuple(-INF, false)) {}
 
     //! @brief Initialising constructor.
-    netstate(field<tuple<times_t, bool>> data) : data(data) {}
+    field_netstate(field<tuple<times_t, bool>> data) : data(data) {
+        summarise();
+    }
 
     //! @brief Updates the data stored for a single device.
     void update(device_t id, times_t time, bool val) {
-        fcpp::details::self(data, id) = make_tuple(time,val);
+        tuple<times_t, bool>& t = fcpp::details::self(data, id);
+        bool latest = get<1>(t) and get<0>(t) == m_last_true;
+        t = make_tuple(time,val);
+        if (latest and (not val or time < m_last_true)) summarise();
+        else if (val) m_last_true = std::max(m_last_true, time);
+    }
+
+    /**
+     * @brief Turns the true stored for a device (if any) into a false with the given timestamp.
+     *
+     * Such a tombstone is not renewed by further retractions, so that it expires as the true
+     * entries it hides. Devices without a stored true are left without data.
+     */
+    void retract(device_t id, times_t time) {
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        size_t i = std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+        if (i < ids.size() and ids[i] == id and get<1>(fcpp::details::get_vals(data)[i+1]))
+            update(id, time, false);
     }
 
     //! @brief Checks whether there is a true stored for a device with a timestamp after the threshold.
     bool value(times_t threshold) const {
-        for (auto const& t : fcpp::details::get_vals(data))
-            if (get<0>(t) > threshold and get<1>(t))
-                return true;
-        return false;
+        return m_last_true > threshold;
+    }
+
+    //! @brief The latest timestamp of a true entry (-INF if there is none).
+    times_t last_true() const {
+        return m_last_true;
+    }
+
+    //! @brief The number of devices with some stored data.
+    size_t size() const {
+        return fcpp::details::get_ids(data).size();
     }
 
     //! @brief Calculates the pointwise maximum of two netstates.
-    static netstate max(netstate const& x, netstate const& y) {
+    static field_netstate max(field_netstate const& x, field_netstate const& y) {
         return fcpp::max(x.data, y.data);
     }
 
-    //! @brief Serialises the content from/to a given input/output stream.
+    //! @brief Calculates the pointwise maximum of the netstates in a field (by pairwise maximum of the data, summarised once).
+    static field_netstate merge(field<field_netstate> const& n) {
+        field_netstate r;
+        for (field_netstate const& x : fcpp::details::get_vals(n))
+            r.data = fcpp::max(r.data, x.data);
+        r.summarise();
+        return r;
+    }
+
+    /**
+     * @brief Removes the entries with timestamps not after the threshold.
+     *
+     * Such entries cannot affect the value for the threshold or later ones: true entries are too old
+     * to be counted, and false entries can only hide true entries for the same device which are even older.
+     */
+    void prune(times_t threshold) {
+        field_netstate r;
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        std::vector<tuple<times_t, bool>> const& vals = fcpp::details::get_vals(data);
+        for (size_t i = 0; i < ids.size(); ++i)
+            if (get<0>(vals[i+1]) > threshold)
+                fcpp::details::self(r.data, ids[i]) = vals[i+1];
+        r.m_last_true = m_last_true > threshold ? m_last_true : -INF;
+        *this = std::move(r);
+    }
+
+    //! @brief Restricts to the entries which differ from those in a previous netstate.
+    field_netstate delta(field_netstate const& prev) const {
+        field_netstate d;
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        std::vector<tuple<times_t, bool>> const& vals = fcpp::details::get_vals(data);
+        for (size_t i = 0; i < ids.size(); ++i)
+            if (vals[i+1] != fcpp::details::self(prev.data, ids[i]))
+                fcpp::details::self(d.data, ids[i]) = vals[i+1];
+        d.summarise();
+        return d;
+    }
+
+    //! @brief Serialises the content from a given input stream (in compact form).
     template <typename S>
     S& serialize(S& s) {
-        return s & data;
+        data = field<tuple<times_t, bool>>(make_tuple(-INF, false));
+        compact::read<bool>(s, [this](device_t id, times_t time, bool val){
+            fcpp::details::self(data, id) = make_tuple(time, val);
+        });
+        summarise();
+        return s;
     }
 
-    //! @brief Serialises the content from/to a given input/output stream (const overload).
+    //! @brief Serialises the content to a given output stream (in compact form).
     template <typename S>
     S& serialize(S& s) const {
-        return s << data;
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        std::vector<tuple<times_t, bool>> const& vals = fcpp::details::get_vals(data);
+        return compact::write(s, ids.size(), [&](size_t i){
+            return make_tuple(ids[i], get<0>(vals[i+1]), get<1>(vals[i+1]));
+        });
     }
 
-    //! @brief The actual data, stored as a field of tuples.
+    //! @brief The actual data, stored as a field of tuples (to be modified through member functions only).
     field<tuple<times_t, bool>> data;
+
+  private:
+    //! @brief Recomputes the latest timestamp of a true entry.
+    void summarise() {
+        m_last_true = -INF;
+        for (auto const& t : fcpp::details::get_vals(data))
+            if (get<1>(t)) m_last_true = std::max(m_last_true, get<0>(t));
+    }
+
+    //! @brief The latest timestamp of a true entry (-INF if there is none).
+    times_t m_last_true = -INF;
+};
+
+/**
+ * @brief Models a view of a data for all devices of a network, stored as parallel vectors sorted by device.
+ *
+ * As for field_netstate, the latest timestamp of a true entry is maintained along with the data.
+ */
+struct flat_netstate {
+    //! @brief Updates the data stored for a single device.
+    void update(device_t id, times_t time, bool val) {
+        size_t i = std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+        bool latest = false;
+        if (i == ids.size() or ids[i] != id) {
+            ids.insert(ids.begin() + i, id);
+            times.insert(times.begin() + i, time);
+            vals.insert(vals.begin() + i, val);
+        } else {
+            latest = vals[i] and times[i] == m_last_true;
+            times[i] = time;
+            vals[i] = val;
+        }
+        if (latest and (not val or time < m_last_true)) summarise();
+        else if (val) m_last_true = std::max(m_last_true, time);
+    }
+
+    //! @brief Turns the true stored for a device (if any) into a false with the given timestamp (see field_netstate::retract).
+    void retract(device_t id, times_t time) {
+        size_t i = std::lower_bound(ids.begin(), ids.end(), id) - ids.begin();
+        if (i < ids.size() and ids[i] == id and vals[i])
+            update(id, time, false);
+    }
+
+    //! @brief Checks whether there is a true stored for a device with a timestamp after the threshold.
+    bool value(times_t threshold) const {
+        return m_last_true > threshold;
+    }
+
+    //! @brief The latest timestamp of a true entry (-INF if there is none).
+    times_t last_true() const {
+        return m_last_true;
+    }
+
+    //! @brief The number of devices with some stored data.
+    size_t size() const {
+        return ids.size();
+    }
+
+    //! @brief Calculates the pointwise maximum of two netstates (by linear merge).
+    static flat_netstate max(flat_netstate const& x, flat_netstate const& y) {
+        flat_netstate r;
+        r.reserve(std::max(x.ids.size(), y.ids.size()));
+        size_t i = 0, j = 0;
+        while (i < x.ids.size() and j < y.ids.size()) {
+            if (x.ids[i] < y.ids[j]) r.push_back(x, i++);
+            else if (y.ids[j] < x.ids[i]) r.push_back(y, j++);
+            else {
+                if (x.newer(i, y.times[j], y.vals[j])) r.push_back(x, i);
+                else r.push_back(y, j);
+                ++i; ++j;
+            }
+        }
+        for (; i < x.ids.size(); ++i) r.push_back(x, i);
+        for (; j < y.ids.size(); ++j) r.push_back(y, j);
+        r.summarise();
+        return r;
+    }
+
+    //! @brief Calculates the pointwise maximum of the netstates in a field (by k-way merge in a single pass).
+    static flat_netstate merge(field<flat_netstate> const& n) {
+        std::vector<flat_netstate> const& v = fcpp::details::get_vals(n);
+        // heap of cursors into the netstates, with the smallest next device on top
+        std::vector<cursor> heap;
+        size_t largest = 0;
+        for (size_t k = 0; k < v.size(); ++k) if (not v[k].ids.empty()) {
+            heap.push_back({v[k].ids[0], k, 0});
+            largest = std::max(largest, v[k].ids.size());
+        }
+        std::make_heap(heap.begin(), heap.end());
+        flat_netstate r;
+        r.reserve(largest);
+        while (not heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end());
+            cursor& c = heap.back();
+            flat_netstate const& x = v[c.state];
+            if (r.ids.empty() or r.ids.back() != c.id)
+                r.push_back(x, c.pos);
+            else if (x.newer(c.pos, r.times.back(), r.vals.back())) {
+                r.times.back() = x.times[c.pos];
+                r.vals.back() = x.vals[c.pos];
+            }
+            if (++c.pos < x.ids.size()) {
+                c.id = x.ids[c.pos];
+                std::push_heap(heap.begin(), heap.end());
+            } else heap.pop_back();
+        }
+        r.summarise();
+        return r;
+    }
+
+    //! @brief Removes the entries with timestamps not after the threshold (see field_netstate::prune).
+    void prune(times_t threshold) {
+        size_t j = 0;
+        for (size_t i = 0; i < ids.size(); ++i) if (times[i] > threshold) {
+            ids[j] = ids[i];
+            times[j] = times[i];
+            vals[j] = vals[i];
+            ++j;
+        }
+        ids.resize(j);
+        times.resize(j);
+        vals.resize(j);
+        if (m_last_true <= threshold) m_last_true = -INF;
+    }
+
+    //! @brief Restricts to the entries which differ from those in a previous netstate.
+    flat_netstate delta(flat_netstate const& prev) const {
+        flat_netstate d;
+        size_t j = 0;
+        for (size_t i = 0; i < ids.size(); ++i) {
+            while (j < prev.ids.size() and prev.ids[j] < ids[i]) ++j;
+            if (j == prev.ids.size() or prev.ids[j] != ids[i] or prev.times[j] != times[i] or prev.vals[j] != vals[i])
+                d.push_back(*this, i);
+        }
+        d.summarise();
+        return d;
+    }
+
+    //! @brief Serialises the content from a given input stream (in compact form).
+    template <typename S>
+    S& serialize(S& s) {
+        ids.clear();
+        times.clear();
+        vals.clear();
+        compact::read<bool>(s, [this](device_t id, times_t time, bool val){
+            ids.push_back(id);
+            times.push_back(time);
+            vals.push_back(val);
+        });
+        summarise();
+        return s;
+    }
+
+    //! @brief Serialises the content to a given output stream (in compact form).
+    template <typename S>
+    S& serialize(S& s) const {
+        return compact::write(s, ids.size(), [this](size_t i){
+            return make_tuple(ids[i], times[i], vals[i] > 0);
+        });
+    }
+
+    //! @brief The devices with some stored data, in increasing order (to be modified through member functions only).
+    std::vector<device_t> ids;
+    //! @brief The timestamp stored for each device.
+    std::vector<times_t> times;
+    //! @brief The truth value stored for each device.
+    std::vector<uint8_t> vals;
+
+  private:
+    //! @brief A position inside a netstate, during a k-way merge.
+    struct cursor {
+        //! @brief The device at the current position.
+        device_t id;
+        //! @brief The index of the netstate.
+        size_t state;
+        //! @brief The current position in the netstate.
+        size_t pos;
+
+        //! @brief Ordering for a max-heap with the smallest device on top.
+        bool operator<(cursor const& o) const {
+            return id > o.id;
+        }
+    };
+
+    //! @brief Whether the i-th entry is newer than a given one (ties broken in favour of true values).
+    bool newer(size_t i, times_t time, uint8_t val) const {
+        return times[i] > time or (times[i] == time and vals[i] > val);
+    }
+
+    //! @brief Recomputes the latest timestamp of a true entry (branch-free, so that it can be vectorised).
+    void summarise() {
+        times_t t = -INF;
+        for (size_t i = 0; i < ids.size(); ++i)
+            t = std::max(t, vals[i] ? times[i] : times_t(-INF));
+        m_last_true = t;
+    }
+
+    //! @brief Reserves space for a given number of entries.
+    void reserve(size_t n) {
+        ids.reserve(n);
+        times.reserve(n);
+        vals.reserve(n);
+    }
+
+    //! @brief Appends the i-th entry of another netstate.
+    void push_back(flat_netstate const& x, size_t i) {
+        ids.push_back(x.ids[i]);
+        times.push_back(x.times[i]);
+        vals.push_back(x.vals[i]);
+    }
+
+    //! @brief The latest timestamp of a true entry (-INF if there is none).
+    times_t m_last_true = -INF;
 };
 
-//! @brief Fastest and heaviest implementation.
+//! @brief Whether netstates are stored as flat sorted vectors (true) or as fields (false).
+#ifndef FCPP_NETSTATE_FLAT
+#define FCPP_NETSTATE_FLAT false
+#endif
+
+//! @brief Models a view of a data for all devices of a network (with backend selected by FCPP_NETSTATE_FLAT).
+using netstate = std::conditional_t<FCPP_NETSTATE_FLAT, flat_netstate, field_netstate>;
+
+/**
+ * @brief Models a view of a word of up to 64 truth values for all devices of a network, stored as a field.
+ *
+ * Each bit corresponds to a different proposition, so that merges and pruning handle all of them at once.
+ */
+struct multi_netstate {
+    //! @brief Default constructor.
+    multi_netstate() : data(make_tuple(-INF, uint64_t(0))) {}
+
+    //! @brief Initialising constructor.
+    multi_netstate(field<tuple<times_t, uint64_t>> data) : data(data) {}
+
+    //! @brief Updates the data stored for a single device.
+    void update(device_t id, times_t time, uint64_t vals) {
+        fcpp::details::self(data, id) = make_tuple(time, vals);
+    }
+
+    //! @brief Bitwise or of the words stored with a timestamp after the threshold.
+    uint64_t value(times_t threshold) const {
+        uint64_t r = 0;
+        for (auto const& t : fcpp::details::get_vals(data))
+            if (get<0>(t) > threshold) r |= get<1>(t);
+        return r;
+    }
+
+    //! @brief Calculates the pointwise maximum of two netstates.
+    static multi_netstate max(multi_netstate const& x, multi_netstate const& y) {
+        return fcpp::max(x.data, y.data);
+    }
+
+    //! @brief Calculates the pointwise maximum of the netstates in a field (by pairwise maximum).
+    static multi_netstate merge(field<multi_netstate> const& n) {
+        multi_netstate r;
+        for (multi_netstate const& x : fcpp::details::get_vals(n))
+            r = max(r, x);
+        return r;
+    }
+
+    //! @brief Removes the entries with timestamps not after the threshold.
+    void prune(times_t threshold) {
+        multi_netstate r;
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        std::vector<tuple<times_t, uint64_t>> const& vals = fcpp::details::get_vals(data);
+        for (size_t i = 0; i < ids.size(); ++i)
+            if (get<0>(vals[i+1]) > threshold)
+                fcpp::details::self(r.data, ids[i]) = vals[i+1];
+        *this = std::move(r);
+    }
+
+    //! @brief Serialises the content from a given input stream (in compact form).
+    template <typename S>
+    S& serialize(S& s) {
+        data = field<tuple<times_t, uint64_t>>(make_tuple(-INF, uint64_t(0)));
+        return compact::read<uint64_t>(s, [this](device_t id, times_t time, uint64_t vals){
+            fcpp::details::self(data, id) = make_tuple(time, vals);
+        });
+    }
+
+    //! @brief Serialises the content to a given output stream (in compact form).
+    template <typename S>
+    S& serialize(S& s) const {
+        std::vector<device_t> const& ids = fcpp::details::get_ids(data);
+        std::vector<tuple<times_t, uint64_t>> const& vals = fcpp::details::get_vals(data);
+        return compact::write(s, ids.size(), [&](size_t i){
+            return make_tuple(ids[i], get<0>(vals[i+1]), get<1>(vals[i+1]));
+        });
+    }
+
+    //! @brief The actual data, stored as a field of tuples (to be modified through member functions only).
+    field<tuple<times_t, uint64_t>> data;
+};
+
+//! @brief Fastest and heaviest implementation (dropping entries too old to affect the result).
 struct fastest {
     FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed) const { CODE
         return nbr(CALL, netstate{}, [&](field<netstate> n){
-            netstate s = fold_hood(CALL, netstate::max, n);
+            netstate s = netstate::merge(n);
             s.update(node.uid, node.current_time(), f);
-            return make_tuple(s.value(node.current_time() - diameter / infospeed), std::move(s));
+            times_t threshold = node.current_time() - diameter / infospeed;
+            s.prune(threshold);
+            return make_tuple(s.value(threshold), std::move(s));
+        });
+    }
+    FUN_EXPORT export_t = export_list<netstate>;
+};
+
+/**
+ * @brief Fastest implementation, sharing only the entries changed since the previous round.
+ *
+ * The full netstate is kept locally and merged with the deltas received from neighbours.
+ * Every `refresh` rounds (which must be positive) the full netstate is shared instead,
+ * so that devices missing some deltas (e.g. newly connected ones) eventually recover.
+ */
+struct delta_fastest {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, size_t refresh) const { CODE
+        return old(CALL, make_tuple(netstate{}, size_t{0}), [&](tuple<netstate, size_t> const& o){
+            netstate s;
+            bool v = nbr(CALL, netstate{}, [&](field<netstate> n){
+                s = netstate::max(get<0>(o), netstate::merge(n));
+                s.update(node.uid, node.current_time(), f);
+                times_t threshold = node.current_time() - diameter / infospeed;
+                s.prune(threshold);
+                netstate d = get<1>(o) % refresh == 0 ? s : s.delta(get<0>(o));
+                return make_tuple(s.value(threshold), std::move(d));
+            });
+            return make_tuple(v, make_tuple(std::move(s), get<1>(o) + 1));
+        });
+    }
+    FUN_EXPORT export_t = export_list<netstate, tuple<netstate, size_t>>;
+};
+
+/**
+ * @brief Fastest implementation, storing only devices which are true or have recently retracted a true.
+ *
+ * A device which is false only stores a tombstone for itself if it had a true stored, so that
+ * devices which never were true are not stored at all.
+ */
+struct sparse_fastest {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed) const { CODE
+        return nbr(CALL, netstate{}, [&](field<netstate> n){
+            netstate s = netstate::merge(n);
+            if (f) s.update(node.uid, node.current_time(), true);
+            else s.retract(node.uid, node.current_time());
+            times_t threshold = node.current_time() - diameter / infospeed;
+            s.prune(threshold);
+            return make_tuple(s.value(threshold), std::move(s));
         });
     }
     FUN_EXPORT export_t = export_list<netstate>;
 };
 
+/**
+ * @brief Hierarchical fastest implementation, storing data for single devices only within clusters.
+ *
+ * Cluster heads are elected within a number of hops about the square root of the diameter, so that both
+ * the devices in a cluster and the clusters in the network grow as the square root of the devices.
+ * Each device shares the netstate of its cluster, and a netstate keyed by cluster heads holding the
+ * verdict of each cluster, published by its head only. Thus a device turning false is first retracted
+ * within its cluster, and then the false verdict of the cluster overrides its earlier true among clusters.
+ * A device ceasing to be a head publishes a false verdict, overriding the one of its former cluster.
+ */
+struct hierarchical_fastest {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed) const { CODE
+        hops_t size = std::ceil(std::sqrt(real_t(diameter)));
+        device_t head = diameter_election(CALL, node.uid, size);
+        times_t threshold = node.current_time() - diameter / infospeed;
+        times_t last = split(CALL, head, [&](){
+            return nbr(CALL, netstate{}, [&](field<netstate> n){
+                netstate s = netstate::merge(n);
+                s.update(node.uid, node.current_time(), f);
+                s.prune(threshold);
+                return make_tuple(s.last_true(), std::move(s));
+            });
+        });
+        bool leader = head == node.uid;
+        bool was_leader = old(CALL, false, leader);
+        return nbr(CALL, netstate{}, [&](field<netstate> n){
+            netstate s = netstate::merge(n);
+            if (leader) s.update(node.uid, node.current_time(), last > threshold);
+            else if (was_leader) s.update(node.uid, node.current_time(), false);
+            s.prune(threshold);
+            return make_tuple(s.value(threshold), std::move(s));
+        });
+    }
+    FUN_EXPORT export_t = export_list<diameter_election_t<device_t>, bool, netstate>;
+};
+
+/**
+ * @brief Fastest implementation, sending each neighbour only the entries it is missing.
+ *
+ * Messages carry a sequence number, and each neighbour acknowledges the latest message it read from
+ * the device. Since messages are deltas with respect to what a neighbour acknowledged, reading one
+ * gives the neighbour the whole netstate of the device when it was sent: thus the acknowledged netstates
+ * (kept until acknowledged or expired) together with the entries sent by a neighbour are known to be held
+ * by it, and only newer entries are sent to it, even if some messages were overwritten before being read.
+ * Neighbours which have not sent anything yet receive nothing, until their first message is received.
+ * The average and maximum number of entries sent to single neighbours are written into the last two arguments.
+ */
+struct tailored_fastest {
+    //! @brief A message to a neighbour: sequence number, latest sequence number read from the neighbour, entries.
+    using message_t = tuple<size_t, size_t, netstate>;
+    //! @brief A netstate sent, not yet acknowledged by every neighbour: sequence number, time, netstate.
+    using snapshot_t = tuple<size_t, times_t, netstate>;
+    //! @brief The state across rounds: netstate, netstates known to neighbours, snapshots, sequence number.
+    using state_t = tuple<netstate, field<netstate>, std::vector<snapshot_t>, size_t>;
+
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, double& link_mean, size_t& link_max) const { CODE
+        times_t threshold = node.current_time() - diameter / infospeed;
+        return old(CALL, state_t(netstate{}, field<netstate>(netstate{}), std::vector<snapshot_t>{}, size_t{0}), [&](state_t const& o){
+            size_t seq = get<3>(o) + 1;
+            std::vector<snapshot_t> const& history = get<2>(o);
+            netstate s;
+            field<netstate> known;
+            size_t acked = seq;
+            bool v = nbr(CALL, message_t(0, 0, netstate{}), [&](field<message_t> n){
+                s = netstate::max(get<0>(o), netstate::merge(map_hood(CALL, [](message_t const& m){
+                    return get<2>(m);
+                }, n)));
+                s.update(node.uid, node.current_time(), f);
+                s.prune(threshold);
+                known = map_hood(CALL, [&](netstate const& k, message_t const& m){
+                    netstate r = netstate::max(k, get<2>(m));
+                    for (snapshot_t const& h : history)
+                        if (get<0>(h) == get<1>(m)) r = netstate::max(r, get<2>(h));
+                    r.prune(threshold);
+                    return r;
+                }, get<1>(o), n);
+                field<message_t> out = map_hood(CALL, [&](netstate const& k, message_t const& m){
+                    return message_t(seq, get<0>(m), s.delta(k));
+                }, known, n);
+                fcpp::details::other(out) = message_t(seq, 0, netstate{});
+                fcpp::details::self(out, node.uid) = message_t(seq, 0, netstate{});
+                std::vector<device_t> const& ids = fcpp::details::get_ids(n);
+                std::vector<message_t> const& vals = fcpp::details::get_vals(n);
+                for (size_t i = 0; i < ids.size(); ++i)
+                    if (ids[i] != node.uid) acked = std::min(acked, get<1>(vals[i+1]));
+                link_stats(node.uid, out, link_mean, link_max);
+                return make_tuple(s.value(threshold), std::move(out));
+            });
+            // keeps the snapshots which some neighbour may still acknowledge, and are not expired
+            std::vector<snapshot_t> h;
+            for (snapshot_t const& x : history)
+                if (get<0>(x) >= acked and get<1>(x) > threshold) h.push_back(x);
+            h.emplace_back(seq, node.current_time(), s);
+            return make_tuple(v, state_t(std::move(s), std::move(known), std::move(h), seq));
+        });
+    }
+    FUN_EXPORT export_t = export_list<message_t, state_t>;
+
+  private:
+    //! @brief Computes the average and maximum number of entries sent to neighbours other than self.
+    static void link_stats(device_t uid, field<message_t> const& out, double& link_mean, size_t& link_max) {
+        std::vector<device_t> const& ids = fcpp::details::get_ids(out);
+        std::vector<message_t> const& vals = fcpp::details::get_vals(out);
+        size_t count = 0, total = 0;
+        link_max = 0;
+        for (size_t i = 0; i < ids.size(); ++i) if (ids[i] != uid) {
+            size_t entries = get<2>(vals[i+1]).size();
+            ++count;
+            total += entries;
+            link_max = std::max(link_max, entries);
+        }
+        link_mean = count > 0 ? double(total) / count : 0;
+    }
+};
+
+/**
+ * @brief Implementation gossiping only the latest time at which the formula was seen true.
+ *
+ * Timestamps age in real time as they travel, by the delay of each hop (about the inverse of infospeed),
+ * so that they also account for the distance from where the formula was true: they are within
+ * diameter/infospeed from the current time only when that is within the diameter, and it was recently.
+ */
+struct timestamp_gossip {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed) const { CODE
+        return nbr(CALL, times_t(-INF), [&](field<times_t> n){
+            times_t t = f ? node.current_time() : max_hood(CALL, n);
+            return make_tuple(t > node.current_time() - diameter / infospeed, t);
+        });
+    }
+    FUN_EXPORT export_t = export_list<times_t>;
+};
+
+/**
+ * @brief Implementation switching between the fastest and baseline ones, depending on the estimated network size.
+ *
+ * The number of devices (and thus of netstate entries) is estimated from the neighbourhood size
+ * and the diameter, assuming a uniform deployment on a square whose diagonal spans half the diameter.
+ * The neighbourhood size is gossiped as a slowly decaying maximum, so that devices agree on the choice.
+ * The fastest implementation is used while the estimate is within the budget (with some hysteresis
+ * to avoid frequent switches), the baseline otherwise.
+ */
+struct hybrid {
+    FUN bool operator()(ARGS, bool f, hops_t diameter, real_t infospeed, size_t budget) const { CODE
+        real_t nbrs = nbr(CALL, real_t(0), [&](field<real_t> n){
+            real_t k = std::max(real_t(count_hood(CALL)), max_hood(CALL, n) * real_t(0.99));
+            return make_tuple(k, k);
+        });
+        real_t devices = nbrs * diameter * diameter / (8 * 3.141592653589793);
+        bool heavy = old(CALL, true, [&](bool h){
+            bool r = devices <= (h ? 1 : 0.8) * budget;
+            return make_tuple(r, r);
+        });
+        if (heavy) return fastest{}(CALL, f, diameter, infospeed);
+        return baseline{}(CALL, f, diameter);
+    }
+    FUN_EXPORT export_t = export_list<real_t, bool, fastest::export_t, baseline::export_t>;
+};
+
+/**
+ * @brief Baseline implementation for N propositions at once, with hop counts saturating at the diameter.
+ *
+ * Hop counts are stored in an array of bytes, so that the results coincide with those of the baseline
+ * for diameters up to 255, and the loops over propositions can be vectorised.
+ */
+template <size_t N>
+struct multi_baseline {
+    //! @brief The type of hop counts for all propositions.
+    using hops_type = std::array<uint8_t, N>;
+
+    FUN std::bitset<N> operator()(ARGS, std::bitset<N> const& f, hops_t diameter) const { CODE
+        uint8_t d = std::min<size_t>(diameter, 255);
+        hops_type init;
+        init.fill(d);
+        return nbr(CALL, init, [&](field<hops_type> n){
+            return round(n, node.uid, f, d);
+        });
+    }
+    FUN_EXPORT export_t = export_list<hops_type>;
+
+    //! @brief A round given the hop counts of neighbours (and self), returning the results and the hop counts to be shared.
+    static tuple<std::bitset<N>, hops_type> round(field<hops_type> const& n, device_t uid, std::bitset<N> const& f, uint8_t d) {
+        std::vector<device_t> const& ids = fcpp::details::get_ids(n);
+        std::vector<hops_type> const& vals = fcpp::details::get_vals(n);
+        hops_type h;
+        h.fill(d);
+        for (size_t j = 0; j < ids.size(); ++j) if (ids[j] != uid)
+            for (size_t i = 0; i < N; ++i) h[i] = std::min(h[i], vals[j+1][i]);
+        std::bitset<N> r;
+        for (size_t i = 0; i < N; ++i) {
+            h[i] = f[i] ? 0 : std::min(h[i] + 1, int(d));
+            r[i] = h[i] < d;
+        }
+        return make_tuple(r, h);
+    }
+};
+
+/**
+ * @brief Bitwise replicated implementation for N propositions at once (with N up to 64).
+ *
+ * As in bitwise_replicated, but the roles of bits and words are swapped: the word at index
+ * `e-k` holds the values of replica `k` for all propositions, so that shifting to the current
+ * epoch moves whole words, and merging and setting the propositions are bitwise operations.
+ */
+template <size_t N>
+struct multi_replicated {
+    static_assert(N <= 64, "at most 64 propositions are supported");
+
+    FUN std::bitset<N> operator()(ARGS, std::bitset<N> const& f, hops_t diameter, real_t infospeed, size_t replicas) const { CODE
+        size_t epoch = replica_clock(CALL, diameter / infospeed / (replicas-1));
+        return nbr(CALL, make_tuple(size_t(0), std::vector<uint64_t>{}), [&](field<tuple<size_t, std::vector<uint64_t>>> n){
+            return round(n, f, epoch, replicas);
+        });
+    }
+    FUN_EXPORT export_t = export_list<replica_clock_t, tuple<size_t, std::vector<uint64_t>>>;
+
+    //! @brief A round given the epochs and words of neighbours, returning the results and the epoch and words to be shared.
+    static tuple<std::bitset<N>, tuple<size_t, std::vector<uint64_t>>> round(field<tuple<size_t, std::vector<uint64_t>>> const& n, std::bitset<N> const& f, size_t epoch, size_t replicas) {
+        size_t e = epoch;
+        for (auto const& x : fcpp::details::get_vals(n))
+            e = std::max(e, get<0>(x));
+        std::vector<uint64_t> words(replicas, f.to_ullong());
+        for (auto const& x : fcpp::details::get_vals(n))
+            for (size_t i = 0, j = e - get<0>(x); j < replicas and i < get<1>(x).size(); ++i, ++j)
+                words[j] |= get<1>(x)[i];
+        std::bitset<N> r(words[std::min(replicas-1, e)]);
+        return make_tuple(r, make_tuple(e, std::move(words)));
+    }
+};
+
+//! @brief Fastest implementation for N propositions at once (with N up to 64), sharing a single netstate.
+template <size_t N>
+struct multi_fastest {
+    static_assert(N <= 64, "at most 64 propositions are supported");
+
+    FUN std::bitset<N> operator()(ARGS, std::bitset<N> const& f, hops_t diameter, real_t infospeed) const { CODE
+        return nbr(CALL, multi_netstate{}, [&](field<multi_netstate> n){
+            return round(n, node.uid, node.current_time(), f, node.current_time() - diameter / infospeed);
+        });
+    }
+    FUN_EXPORT export_t = export_list<multi_netstate>;
+
+    //! @brief A round given the netstates of neighbours, returning the results and the netstate to be shared.
+    static tuple<std::bitset<N>, multi_netstate> round(field<multi_netstate> const& n, device_t uid, times_t now, std::bitset<N> const& f, times_t threshold) {
+        multi_netstate s = multi_netstate::merge(n);
+        s.update(uid, now, f.to_ullong());
+        s.prune(threshold);
+        return make_tuple(std::bitset<N>(s.value(threshold)), std::move(s));
+    }
+};
+
 } // namespace somewhere
 
 } // namespace coordination
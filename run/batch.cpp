@@ -5,22 +5,39 @@
  * @brief Runs multiple executions non-interactively from the command line, producing overall plots.
  */
 
+#include <cctype>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "lib/setup.hpp"
 
 using namespace fcpp;
 
-int main() {
-    //! @brief Construct the plotter object.
-    option::plot_t p;
-    //! @brief The component type (batch simulator with given options).
-    using comp_t = component::batch_simulator<option::list>;
-    //! @brief The list of initialisation values to be used for simulations.
-    auto init_list = batch::make_tagged_tuple_sequence(
-        batch::arithmetic<option::seed >(0, 9, 1),      // 10 different random seeds
-        batch::arithmetic<option::speed>(0, 48, 4, 10), // 25 different speeds
-        batch::arithmetic<option::dens >(5, 20, 2, 10), // 25 different densities (29)
-        batch::arithmetic<option::hops >(1, 10, 2, 10), // 25 different hop sizes (25)
-        batch::arithmetic<option::tvar >(0, 48, 4, 10), // 25 different time variances
+//! @brief The values of a factor in the sequence sweeping factor i: its range if it is factor j, its default value otherwise.
+template <size_t i, size_t j, typename T, typename V>
+auto factor(V min, V max, V step, V def) {
+    if constexpr (i == j) return batch::arithmetic<T>(min, max, step);
+    else return batch::constant<T>(def);
+}
+
+/**
+ * @brief The sequence of runs sweeping factor i (none if zero), with every other factor at its default value.
+ *
+ * The plots only use runs where at most one factor leaves its default value, and the ranges do not contain
+ * the defaults, so that the sequences for i = 0..7 together contain each of those runs exactly once.
+ */
+template <size_t i>
+auto one_factor(option::plotter_t& p) {
+    return batch::make_tagged_tuple_sequence(
+        batch::arithmetic<option::seed>(0, 9, 1),       // 10 different random seeds
+        factor<i, 1, option::speed>(0, 48, 4, 10),      // 13 different speeds
+        factor<i, 2, option::dens >(5, 20, 2, 10),      // 8 different densities
+        factor<i, 3, option::hops >(1, 10, 2, 10),      // 5 different hop sizes
+        factor<i, 4, option::tvar >(0, 48, 4, 10),      // 13 different time variances
+        factor<i, 5, option::replicas >(2, 10, 2, 3),   // 5 different replica counts
+        factor<i, 6, option::infospeed>(0.0, 4.5, 1.5, 2.0), // 4 different information speeds (0 estimates it online)
+        factor<i, 7, option::lane>(1, int(lanes), 1, 0),     // every implementation alone in its lane (0 runs all of them)
         // generate output file name for the run
         batch::stringify<option::output>("output/batch", "txt"),
         // computes side length from hops
@@ -29,8 +46,85 @@ int main() {
         batch::formula<option::devices, size_t>(option::device_formula{}),
         batch::constant<option::plotter>(&p) // reference to the plotter object
     );
-    //! @brief Runs the given simulations.
-    batch::run(comp_t{}, init_list);
+}
+
+//! @brief The journal file of a shard of the batch runs.
+std::string shard_file(size_t shard, size_t shards) {
+    if (shards == 1) return "output/batch.journal";
+    return "output/batch-" + std::to_string(shard) + "-of-" + std::to_string(shards) + ".journal";
+}
+
+/**
+ * @brief Parses a count from a command line argument, which must be a positive integer (or zero if `zero`).
+ *
+ * Throws std::invalid_argument or std::out_of_range otherwise.
+ */
+size_t parse_count(std::string const& arg, bool zero = false) {
+    if (arg.empty() or not std::isdigit(static_cast<unsigned char>(arg[0]))) throw std::invalid_argument(arg);
+    size_t end;
+    size_t n = std::stoul(arg, &end);
+    if (end != arg.size() or (n == 0 and not zero)) throw std::invalid_argument(arg);
+    return n;
+}
+
+/**
+ * @brief Runs the batch simulations, or a shard of them, or merges the results of the shards.
+ *
+ * Usage:
+ * - `batch [threads]` runs every simulation and produces the plots;
+ * - `batch threads shard shards` runs the given shard of the simulations, recording them in its journal;
+ * - `batch merge shards` produces the plots from the journals of every shard;
+ * - `batch scaling` times the runs with default parameters on 1, 2, 4 and all cores, without producing plots.
+ */
+int main(int argc, char** argv) {
+    //! @brief Construct the plotter object.
+    option::plotter_t p;
+    //! @brief The component type (batch simulator with given options).
+    using comp_t = component::batch_simulator<option::list>;
+    //! @brief The mode of execution, from the first argument.
+    std::string mode = argc > 1 ? argv[1] : "";
+    //! @brief Whether the results of the shards are to be merged.
+    bool merge = mode == "merge";
+    if (mode == "scaling" and argc == 2) {
+        //! @brief The numbers of threads to be compared: 1, 2, 4 and every core.
+        std::vector<size_t> threads = {1, 2, 4};
+        size_t cores = std::thread::hardware_concurrency();
+        if (cores > 4) threads.push_back(cores);
+        runner::scaling<option::plot_t>(comp_t{}, threads, option::cost_formula{}, one_factor<0>(p));
+        return 0;
+    }
+    //! @brief The execution settings (threads from the first argument, or the number of cores).
+    runner::settings opt;
+    opt.threads = std::max(1u, std::thread::hardware_concurrency());
+    try {
+        if (merge and argc == 3) {
+            opt.shards = parse_count(argv[2]);
+        } else if (not merge and argc != 3 and argc <= 4) {
+            if (argc > 1) opt.threads = parse_count(argv[1]);
+            if (argc > 3) {
+                opt.shard = parse_count(argv[2], true);
+                opt.shards = parse_count(argv[3]);
+            }
+            if (opt.shard >= opt.shards) throw std::invalid_argument(argv[2]);
+        } else throw std::invalid_argument(mode);
+    } catch (std::logic_error const&) {
+        std::cerr << "usage: " << argv[0] << " [threads [shard shards]] | merge shards | scaling" << std::endl;
+        return 1;
+    }
+    if (merge) {
+        //! @brief Loads the runs of every shard, checking that each journal holds all the runs of its shard.
+        std::vector<std::string> files;
+        for (size_t i = 0; i < opt.shards; ++i) files.push_back(shard_file(i, opt.shards));
+        if (not runner::merge(comp_t{}, files, p, option::cost_formula{}, one_factor<0>(p), one_factor<1>(p), one_factor<2>(p), one_factor<3>(p),
+                              one_factor<4>(p), one_factor<5>(p), one_factor<6>(p), one_factor<7>(p))) return 1;
+    } else {
+        opt.journal = shard_file(opt.shard, opt.shards);
+        //! @brief Runs the given simulations (the defaults, then sweeping one factor at a time), largest first, skipping those in the journal.
+        if (not runner::run(comp_t{}, opt, p, option::cost_formula{}, one_factor<0>(p), one_factor<1>(p), one_factor<2>(p), one_factor<3>(p),
+                            one_factor<4>(p), one_factor<5>(p), one_factor<6>(p), one_factor<7>(p))) return 1;
+        // A single shard only records its runs, to be merged later.
+        if (opt.shards > 1) return 0;
+    }
     //! @brief Builds the resulting plots.
     std::cout << plot::file("batch", p.build(), { {"LOG_LIN", "1"} });
     return 0;
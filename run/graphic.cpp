@@ -13,18 +13,21 @@ int main() {
     using namespace fcpp;
 
     // The plotter object.
-    option::plot_t plotter;
+    option::plotter_t plotter;
     // The network object type (interactive simulator with given options).
     using net_t = component::interactive_simulator<option::list>::net;
     std::cout << "/*\n";
     {
         // The initialisation values (simulation name, texture of the reference plane, node movement speed).
-        auto init_v = common::make_tagged_tuple<option::name, option::speed, option::dens, option::hops, option::tvar, option::side, option::devices, option::plotter>(
+        auto init_v = common::make_tagged_tuple<option::name, option::speed, option::dens, option::hops, option::tvar, option::replicas, option::infospeed, option::lane, option::side, option::devices, option::plotter>(
             "Optimised implementations of SLCS",
             10,
             10,
             10,
             10,
+            3,
+            2,
+            0,
             0,
             0,
             &plotter
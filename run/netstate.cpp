@@ -0,0 +1,154 @@
+// Copyright © 2024 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file netstate.cpp
+ * @brief Compares the netstate backends on synthetic neighbourhoods, printing tables of timings for merges and full rounds of fastest,
+ * and of the amortised cost per formula of multi-proposition implementations.
+ */
+
+#include <chrono>
+#include <random>
+
+#include "lib/fcpp.hpp"
+#include "lib/somewhere.hpp"
+
+using namespace fcpp;
+using namespace coordination::somewhere;
+
+//! @brief Generates a field of `k` random values (for devices 1 to k), drawn from a given generator.
+template <typename T, typename G>
+field<T> random_field(size_t k, std::mt19937& gen, G&& val) {
+    field<T> f{T{}};
+    for (size_t j = 1; j <= k; ++j)
+        fcpp::details::self(f, device_t(j)) = val(gen);
+    return f;
+}
+
+//! @brief Generates a field of `k` random netstates, each with data for `n` devices, drawing values from a given generator.
+template <typename S, typename G>
+field<S> neighbourhood(size_t n, size_t k, std::mt19937& gen, G&& val) {
+    std::uniform_real_distribution<double> time(0, 100);
+    return random_field<S>(k, gen, [&](std::mt19937& g){
+        S s;
+        for (size_t i = 0; i < n; ++i) s.update(i, time(g), val(g));
+        return s;
+    });
+}
+
+//! @brief Generates a field of `k` random netstates, each with data for `n` devices (true with probability 0.1).
+template <typename S>
+field<S> neighbourhood(size_t n, size_t k, std::mt19937& gen) {
+    return neighbourhood<S>(n, k, gen, std::bernoulli_distribution(0.1));
+}
+
+//! @brief Generates a random word of `p` truth values (each true with probability 0.1).
+uint64_t word(size_t p, std::mt19937& gen) {
+    std::bernoulli_distribution val(0.1);
+    uint64_t w = 0;
+    for (size_t b = 0; b < p; ++b) w |= uint64_t(val(gen)) << b;
+    return w;
+}
+
+//! @brief Average time in microseconds for a computation (returning a count) repeated a number of times, given the size of its data.
+template <typename G>
+double average_time(size_t size, G&& fun) {
+    size_t reps = std::max(size_t{1}, size_t{10000000} / size);
+    uint64_t count = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t r = 0; r < reps; ++r)
+        count += fun(r);
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::high_resolution_clock::now() - start;
+    // prevents the computations from being optimised away (the count cannot reach the maximum)
+    if (count == ~uint64_t(0)) std::cerr << count << std::endl;
+    return elapsed.count() / reps;
+}
+
+//! @brief Average time in microseconds for merging `k` netstates with data for `n` devices.
+template <typename S>
+double merge_time(size_t n, size_t k) {
+    std::mt19937 gen(42);
+    field<S> f = neighbourhood<S>(n, k, gen);
+    return average_time(n * k, [&](size_t){
+        return S::merge(f).value(50);
+    });
+}
+
+//! @brief Average time in microseconds for a round of fastest (merge, own update, prune and value) with `k` neighbours and data for `n` devices.
+template <typename S>
+double round_time(size_t n, size_t k) {
+    std::mt19937 gen(42);
+    field<S> f = neighbourhood<S>(n, k, gen);
+    return average_time(n * k, [&](size_t r){
+        S s = S::merge(f);
+        s.update(0, 100, r % 1000 != 0);
+        s.prune(50);
+        return s.value(50);
+    });
+}
+
+/**
+ * @brief Prints the average time in microseconds and the message size in bytes per formula, for a round
+ * of each multi-proposition implementation with N propositions, `k` neighbours and (for multi_fastest)
+ * data for `n` devices. Sizes of multi_baseline and multi_replicated count their payload only.
+ */
+template <size_t N>
+void multi_row(size_t n, size_t k) {
+    constexpr size_t replicas = 3;
+    std::mt19937 gen(42);
+    // the own propositions (and for multi_baseline, the own identifier) are varied in every repetition
+    std::bitset<N> f(word(N, gen));
+    // multi_baseline: hop counts up to 20
+    using hops_type = typename multi_baseline<N>::hops_type;
+    field<hops_type> hb = random_field<hops_type>(k, gen, [](std::mt19937& g){
+        hops_type h;
+        for (auto& x : h) x = g() % 21;
+        return h;
+    });
+    double t_base = average_time(k * N, [&](size_t r){
+        return get<0>(multi_baseline<N>::round(hb, r % (k+1), f ^ std::bitset<N>(r), 20)).count();
+    });
+    // multi_replicated: epochs 100 to 102
+    using words_type = tuple<size_t, std::vector<uint64_t>>;
+    field<words_type> hr = random_field<words_type>(k, gen, [](std::mt19937& g){
+        std::vector<uint64_t> w(replicas);
+        for (auto& x : w) x = word(N, g);
+        return words_type(100 + g() % 3, w);
+    });
+    double t_repl = average_time(k * replicas, [&](size_t r){
+        return get<0>(multi_replicated<N>::round(hr, f ^ std::bitset<N>(r), 102, replicas)).count();
+    });
+    // multi_fastest
+    field<multi_netstate> hf = neighbourhood<multi_netstate>(n, k, gen, [](std::mt19937& g){
+        return word(N, g);
+    });
+    double t_fast = average_time(n * k, [&](size_t r){
+        return get<0>(multi_fastest<N>::round(hf, 0, 100, f ^ std::bitset<N>(r), 50)).count();
+    });
+    size_counter os;
+    os << fcpp::details::get_vals(hf)[1];
+    std::cout << N << "\t" << t_base / N << "\t" << double(sizeof(hops_type)) / N
+              << "\t" << t_repl / N << "\t" << double(sizeof(size_t) + replicas * sizeof(uint64_t)) / N
+              << "\t" << t_fast / N << "\t" << double(os.size()) / N << std::endl;
+}
+
+//! @brief Prints a row for each number of propositions.
+template <size_t... Ns>
+void multi_rows(size_t n, size_t k) {
+    (multi_row<Ns>(n, k), ...);
+}
+
+int main() {
+    std::cout << "devices\tneighbours\tfield (us)\tflat (us)\tspeed-up" << std::endl;
+    for (size_t n : {10, 100, 1000, 10000})
+        for (size_t k : {5, 10, 20}) {
+            double t_field = merge_time<field_netstate>(n, k);
+            double t_flat = merge_time<flat_netstate>(n, k);
+            std::cout << n << "\t" << k << "\t" << t_field << "\t" << t_flat << "\t" << t_field / t_flat << std::endl;
+        }
+    std::cout << std::endl << "devices\tfield round (us)\tflat round (us)" << std::endl;
+    for (size_t n : {10, 100, 1000, 10000})
+        std::cout << n << "\t" << round_time<field_netstate>(n, 10) << "\t" << round_time<flat_netstate>(n, 10) << std::endl;
+    std::cout << std::endl << "propositions\tbaseline (us/formula)\tbaseline (bytes/formula)\treplicated (us/formula)\treplicated (bytes/formula)\tfastest (us/formula)\tfastest (bytes/formula)" << std::endl;
+    multi_rows<1, 2, 4, 8, 16, 32, 64>(1000, 10);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Runs the batch simulations split into shards, as parallel processes, then merges their plots.
+# Usage: run/sharded.sh <batch executable> <shards> [threads per shard]
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <batch executable> <shards> [threads per shard]" >&2
+    exit 1
+fi
+exe="$1"
+shards="$2"
+threads="${3:-1}"
+
+mkdir -p output
+pids=()
+for ((i = 0; i < shards; ++i)); do
+    "$exe" "$threads" "$i" "$shards" &
+    pids+=($!)
+done
+for pid in "${pids[@]}"; do
+    wait "$pid" || exit 1
+done
+"$exe" merge "$shards"